@@ -1,16 +1,76 @@
 #ifndef LSS_BASE_ALGORITHM_H_
 #define LSS_BASE_ALGORITHM_H_
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "base/incumbent.h"
 #include "base/schedule.h"
 #include "base/situation.h"
+#include "base/trace.h"
 
 namespace lss {
 
 class Algorithm {
  public:
+  static constexpr size_t kDefaultTraceCapacity = 1024;
+
   virtual Schedule Run(const Schedule &prev_schedule, Situation new_situation) = 0;
 
+  // Makes Run() record its progress in a ring buffer of `capacity` points, which is
+  // passed to `sink` at the end of every Run(). Tracing is disabled by default.
+  void SetTraceSink(std::shared_ptr<TraceSink> sink, size_t capacity = kDefaultTraceCapacity) {
+    trace_sink_ = sink;
+    trace_ = Trace(capacity);
+  }
+
+  // Makes Run() publish improvements of its best schedule to `incumbent`, which may be
+  // shared with algorithms running concurrently. Disabled by default.
+  void SetIncumbent(std::shared_ptr<Incumbent> incumbent) { incumbent_ = incumbent; }
+
+  // Makes Run() return its best schedule so far once `deadline` passes. Algorithms check
+  // it between their steps (e.g. generations), so they may overrun it by a single step.
+  // There is no deadline by default.
+  void SetDeadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+
   virtual ~Algorithm() = default;
+
+ protected:
+  bool DeadlinePassed() const {
+    return deadline_ != std::chrono::steady_clock::time_point::max()
+        && std::chrono::steady_clock::now() >= deadline_;
+  }
+
+  // Returns nullptr if publishing is disabled.
+  Incumbent *incumbent() { return incumbent_.get(); }
+
+  // Publishes `schedule` scored with ObjectiveFunction(), as fitnesses computed by
+  // algorithms themselves (e.g. by local search states) may differ from it. Returns whether
+  // the schedule became the snapshot; false if publishing is disabled.
+  bool PublishToIncumbent(const Schedule &schedule, Situation situation) {
+    return incumbent_ && incumbent_->Publish(schedule, ObjectiveFunction(schedule, situation));
+  }
+
+  // Returns nullptr if tracing is disabled.
+  Trace *trace() { return trace_sink_ ? &trace_ : nullptr; }
+
+  // Passes the recorded points to the sink and clears them. Should be called
+  // at the end of Run().
+  void FlushTrace(const std::string &algorithm) {
+    if (!trace_sink_) return;
+    trace_sink_->Flush(algorithm, runs_++, trace_);
+    trace_.Clear();
+  }
+
+ private:
+  std::shared_ptr<TraceSink> trace_sink_;
+  Trace trace_{0};
+  std::shared_ptr<Incumbent> incumbent_;
+  std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+  int64_t runs_ = 0;
 };
 
 }  // namespace lss
@@ -0,0 +1,57 @@
+#ifndef LSS_BASE_ALGORITHM_TEST_UTILS_H_
+#define LSS_BASE_ALGORITHM_TEST_UTILS_H_
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "base/algorithm.h"
+#include "base/schedule.h"
+#include "base/situation.h"
+
+namespace lss {
+
+// Assigns job `i` to machine `i` modulo the number of machines, for the first `jobs` jobs.
+inline Schedule BuildScheduleOfJobs(Situation situation, int jobs) {
+  Schedule schedule(situation);
+  for (int i = 0; i < jobs; ++i) {
+    schedule.AssignJob(situation.machines()[i % situation.machines().size()],
+                       situation.jobs()[i]);
+  }
+  return schedule;
+}
+
+// Publishes a schedule of `published_jobs` jobs to the incumbent (if any and if
+// `published_jobs` is not 0), waits for `delay` and returns a schedule of `jobs` jobs.
+// Schedules are built with BuildScheduleOfJobs().
+class AlgorithmFake : public Algorithm {
+ public:
+  explicit AlgorithmFake(int jobs, int published_jobs = 0,
+                         std::chrono::milliseconds delay = std::chrono::milliseconds(0))
+      : jobs_(jobs), published_jobs_(published_jobs), delay_(delay) {}
+
+  Schedule Run(__attribute__((unused)) const Schedule &prev_schedule,
+               Situation new_situation) override {
+    if (published_jobs_)
+      PublishToIncumbent(BuildScheduleOfJobs(new_situation, published_jobs_), new_situation);
+    std::this_thread::sleep_for(delay_);
+    return BuildScheduleOfJobs(new_situation, jobs_);
+  }
+
+ private:
+  int jobs_;
+  int published_jobs_;
+  std::chrono::milliseconds delay_;
+};
+
+class FailingAlgorithm : public Algorithm {
+ public:
+  Schedule Run(__attribute__((unused)) const Schedule &prev_schedule,
+               __attribute__((unused)) Situation new_situation) override {
+    throw std::runtime_error("failure");
+  }
+};
+
+}  // namespace lss
+
+#endif  // LSS_BASE_ALGORITHM_TEST_UTILS_H_
@@ -0,0 +1,68 @@
+// This header provides Bitmap - a fixed size set of dense indices (e.g. Machine::index())
+// stored as 64-bit words. Operations on whole bitmaps are plain loops over words,
+// so they can be vectorized.
+
+#ifndef LSS_BASE_BITMAP_H_
+#define LSS_BASE_BITMAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lss {
+
+class Bitmap {
+ public:
+  Bitmap() = default;
+  explicit Bitmap(size_t size) : size_(size), words_((size + kWordBits - 1) / kWordBits) {}
+
+  size_t size() const { return size_; }
+
+  // Indices out of range are not in the bitmap.
+  bool Test(size_t i) const {
+    return i < size_ && (words_[i / kWordBits] >> (i % kWordBits)) & 1;
+  }
+
+  void Set(size_t i) { words_[i / kWordBits] |= uint64_t(1) << (i % kWordBits); }
+
+  size_t Count() const {
+    size_t count = 0;
+    for (uint64_t word : words_)
+      count += __builtin_popcountll(word);
+    return count;
+  }
+
+  // Intersection; bits beyond the size of `other` are cleared.
+  Bitmap &operator&=(const Bitmap &other) {
+    size_t common = std::min(words_.size(), other.words_.size());
+    for (size_t w = 0; w < common; ++w)
+      words_[w] &= other.words_[w];
+    std::fill(words_.begin() + common, words_.end(), 0);
+    return *this;
+  }
+
+  friend Bitmap operator&(Bitmap lhs, const Bitmap &rhs) { return lhs &= rhs; }
+
+  bool Intersects(const Bitmap &other) const {
+    size_t common = std::min(words_.size(), other.words_.size());
+    uint64_t any = 0;
+    for (size_t w = 0; w < common; ++w)
+      any |= words_[w] & other.words_[w];
+    return any != 0;
+  }
+
+  friend bool operator==(const Bitmap &lhs, const Bitmap &rhs) {
+    return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_;
+  }
+
+ private:
+  static constexpr size_t kWordBits = 64;
+
+  size_t size_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+}  // namespace lss
+
+#endif  // LSS_BASE_BITMAP_H_
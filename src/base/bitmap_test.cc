@@ -0,0 +1,42 @@
+#include "base/bitmap.h"
+
+#include "gtest/gtest.h"
+
+namespace lss {
+namespace {
+
+Bitmap FromIndices(size_t size, std::initializer_list<size_t> indices) {
+  Bitmap bitmap(size);
+  for (size_t i : indices)
+    bitmap.Set(i);
+  return bitmap;
+}
+
+TEST(BitmapTest, SetAndTest) {
+  Bitmap bitmap = FromIndices(130, {0, 63, 64, 129});
+  EXPECT_EQ(130, bitmap.size());
+  EXPECT_EQ(4, bitmap.Count());
+  for (size_t i = 0; i < 130; ++i)
+    EXPECT_EQ(i == 0 || i == 63 || i == 64 || i == 129, bitmap.Test(i)) << i;
+  EXPECT_FALSE(bitmap.Test(130));
+  EXPECT_FALSE(Bitmap().Test(0));
+}
+
+TEST(BitmapTest, Intersection) {
+  Bitmap lhs = FromIndices(200, {1, 70, 150, 199});
+  Bitmap rhs = FromIndices(200, {2, 70, 199});
+  EXPECT_EQ(FromIndices(200, {70, 199}), lhs & rhs);
+  EXPECT_TRUE(lhs.Intersects(rhs));
+  EXPECT_FALSE(FromIndices(200, {1}).Intersects(rhs));
+}
+
+// Verify that bits beyond the shorter bitmap are not in the intersection.
+TEST(BitmapTest, IntersectionOfDifferentSizes) {
+  Bitmap lhs = FromIndices(200, {1, 150});
+  lhs &= FromIndices(64, {1});
+  EXPECT_EQ(FromIndices(200, {1}), lhs);
+  EXPECT_FALSE(FromIndices(200, {150}).Intersects(FromIndices(64, {1})));
+}
+
+}  // namespace
+}  // namespace lss
@@ -0,0 +1,69 @@
+#include "base/imbalance.h"
+
+#include <algorithm>
+
+namespace lss {
+
+ImbalanceEvaluator::ImbalanceEvaluator(Situation situation)
+    : time_stamp_(situation.time_stamp()), horizon_(situation.time_stamp()) {
+  for (FairSet fair_set : situation.fair_sets()) {
+    fair_set_index_[fair_set] = active_machines_.size();
+    int active = 0;
+    for (Machine m : fair_set.machines())
+      active += m.alive();
+    active_machines_.push_back(active);
+    charged_fair_sets_ += active > 0;
+  }
+  for (Account account : situation.accounts()) {
+    account_index_[account] = alloc_.size();
+    alloc_.push_back(account.alloc());
+    alloc_sum_ += account.alloc();
+  }
+}
+
+void ImbalanceEvaluator::AddJob(Machine machine, Job job, Time start, Time finish) {
+  horizon_ = std::max(horizon_, finish);
+  if (!machine)
+    return;
+  auto fair_set = fair_set_index_.find(machine.fair_set());
+  auto account = account_index_.find(job.batch().account());
+  if (fair_set == fair_set_index_.end() || account == account_index_.end())
+    return;
+  int group = fair_set->second * alloc_.size() + account->second;
+  events_.push_back({group, start, 1});
+  events_.push_back({group, finish, -1});
+}
+
+void ImbalanceEvaluator::Clear() {
+  events_.clear();
+  horizon_ = time_stamp_;
+}
+
+double ImbalanceEvaluator::Compute() {
+  // Without running jobs every account is charged its whole allocation...
+  double result = charged_fair_sets_ * alloc_sum_ * (horizon_ - time_stamp_);
+
+  // ...and running jobs decrease the charge by min(alloc, running / n) while they run.
+  std::sort(events_.begin(), events_.end());
+  for (size_t first = 0; first < events_.size();) {
+    int group = events_[first].group;
+    int active = active_machines_[group / alloc_.size()];
+    FloatType alloc = alloc_[group % alloc_.size()];
+    Time prev_time = time_stamp_;
+    int running = 0;
+    size_t i = first;
+    for (; i < events_.size() && events_[i].group == group; ++i) {
+      Time time = std::min(std::max(events_[i].time, time_stamp_), horizon_);
+      if (active > 0) {
+        double share = static_cast<double>(running) / active;
+        result -= std::min<double>(alloc, share) * (time - prev_time);
+      }
+      prev_time = time;
+      running += events_[i].delta;
+    }
+    first = i;
+  }
+  return result;
+}
+
+}  // namespace lss
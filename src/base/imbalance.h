@@ -0,0 +1,57 @@
+#ifndef LSS_BASE_IMBALANCE_H_
+#define LSS_BASE_IMBALANCE_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "base/situation.h"
+
+namespace lss {
+
+// Fair-share imbalance ingredient of the objective function, as charged by the system test
+// scorer (system_tests/internals/objective_function/fair_machine_set.py). For every fair set
+// with `n > 0` machines which are not dead and every account, the imbalance at time `t` is
+// max(0, alloc - running(t) / n), where `running(t)` is the number of jobs of the account
+// running at `t` on machines of the fair set. The ingredient is the integral of imbalances
+// from the time stamp of the situation to the latest finish time of added jobs.
+//
+// Jobs are added one by one (e.g. while simulating a schedule) as start and finish
+// events; Compute() sweeps over them in O(J log J).
+class ImbalanceEvaluator {
+ public:
+  explicit ImbalanceEvaluator(Situation situation);
+
+  // Registers that `job` runs on `machine` during [start, finish). Jobs on machines
+  // outside fair sets are ignored.
+  void AddJob(Machine machine, Job job, Time start, Time finish);
+
+  // Removes all added jobs.
+  void Clear();
+
+  double Compute();
+
+ private:
+  struct Event {
+    int group;  // fair set * number of accounts + account
+    Time time;
+    int delta;
+
+    friend bool operator<(const Event &lhs, const Event &rhs) {
+      return lhs.group < rhs.group || (lhs.group == rhs.group && lhs.time < rhs.time);
+    }
+  };
+
+  Time time_stamp_;
+  Time horizon_;
+  std::unordered_map<FairSet, int> fair_set_index_;
+  std::unordered_map<Account, int> account_index_;
+  std::vector<int> active_machines_;  // Per fair set.
+  std::vector<FloatType> alloc_;      // Per account.
+  FloatType alloc_sum_ = 0;
+  int charged_fair_sets_ = 0;         // Fair sets with at least one active machine.
+  std::vector<Event> events_;
+};
+
+}  // namespace lss
+
+#endif  // LSS_BASE_IMBALANCE_H_
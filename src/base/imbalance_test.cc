@@ -0,0 +1,88 @@
+#include "base/imbalance.h"
+
+#include "gtest/gtest.h"
+
+#include "base/raw_situation.h"
+#include "base/schedule.h"
+
+namespace lss {
+namespace {
+
+// Fair set 0 has two active machines and a dead one, fair set 1 has only a dead machine
+// and machine 3 is outside fair sets. Every fair set with active machines charges
+// 1 + 0.5 per unit of time without running jobs.
+const auto kSample = RawSituation()
+    .add(RawMachine().id(0).state(MachineState::kIdle))
+    .add(RawMachine().id(1).state(MachineState::kIdle))
+    .add(RawMachine().id(2).state(MachineState::kDead))
+    .add(RawMachine().id(3).state(MachineState::kIdle))
+    .add(RawMachine().id(4).state(MachineState::kDead))
+    .add(RawMachineSet().id(0).add(0).add(1).add(2).add(3))
+    .add(RawFairSet().id(0).add(0).add(1).add(2))
+    .add(RawFairSet().id(1).add(4))
+    .add(RawAccount().id(0).alloc(1))
+    .add(RawAccount().id(1).alloc(0.5))
+    .add(RawBatch().id(0).account(0).duration(4))
+    .add(RawBatch().id(1).account(1).duration(4))
+    .add(RawJob().id(0).batch(0).duration(4).machine_set(0))
+    .add(RawJob().id(1).batch(1).duration(4).machine_set(0))
+    .add(RawJob().id(2).batch(1).duration(2).machine_set(0));
+
+class ImbalanceTest : public ::testing::Test {
+ protected:
+  ImbalanceTest() : situation_(kSample, false), imbalance_(situation_) {}
+
+  Machine machine(IdType id) { return situation_[Id<Machine>(id)]; }
+  Job job(IdType id) { return situation_[Id<Job>(id)]; }
+
+  Situation situation_;
+  ImbalanceEvaluator imbalance_;
+};
+
+// Verify that there is no imbalance before the first job finishes.
+TEST_F(ImbalanceTest, NoJobs) {
+  EXPECT_NEAR(0, imbalance_.Compute(), 1e-9);
+}
+
+// Verify that a running job decreases the charge of its account by running / active machines.
+TEST_F(ImbalanceTest, SingleJob) {
+  imbalance_.AddJob(machine(0), job(0), 0, 4);
+  EXPECT_NEAR(1.5 * 4 - 0.5 * 4, imbalance_.Compute(), 1e-9);
+}
+
+// Verify that the decrease of the charge is capped by the allocation of the account.
+TEST_F(ImbalanceTest, ChargeCappedByAlloc) {
+  imbalance_.AddJob(machine(0), job(1), 0, 4);
+  imbalance_.AddJob(machine(1), job(2), 0, 2);
+  EXPECT_NEAR(1.5 * 4 - 0.5 * 2 - 0.5 * 2, imbalance_.Compute(), 1e-9);
+}
+
+// Verify that jobs on machines outside fair sets only extend the horizon.
+TEST_F(ImbalanceTest, MachineOutsideFairSets) {
+  imbalance_.AddJob(machine(3), job(0), 0, 4);
+  imbalance_.AddJob(Machine(), job(1), 0, 4);
+  EXPECT_NEAR(1.5 * 4, imbalance_.Compute(), 1e-9);
+}
+
+TEST_F(ImbalanceTest, Clear) {
+  imbalance_.AddJob(machine(0), job(0), 0, 4);
+  imbalance_.Clear();
+  EXPECT_NEAR(0, imbalance_.Compute(), 1e-9);
+}
+
+// Verify that ObjectiveFunction subtracts the weighted imbalance of the schedule.
+TEST_F(ImbalanceTest, ObjectiveFunction) {
+  Schedule schedule(situation_);
+  schedule.AssignJob(machine(0), job(0));
+  schedule.AssignJob(machine(1), job(2));
+  double objective = ObjectiveFunction(schedule, situation_);
+  EXPECT_EQ(objective, ObjectiveFunction(schedule, situation_, 0.));
+
+  imbalance_.AddJob(machine(0), job(0), 0, 4);
+  imbalance_.AddJob(machine(1), job(2), 0, 2);
+  EXPECT_NEAR(objective - 2 * imbalance_.Compute(),
+              ObjectiveFunction(schedule, situation_, 2.), 1e-9);
+}
+
+}  // namespace
+}  // namespace lss
@@ -0,0 +1,41 @@
+#include "base/incumbent.h"
+
+#include <limits>
+#include <utility>
+
+namespace lss {
+
+Incumbent::Incumbent() : best_fitness_(-std::numeric_limits<double>::infinity()) {}
+
+bool Incumbent::Publish(Schedule schedule, double fitness) {
+  if (fitness <= best_fitness())
+    return false;
+
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->schedule = std::move(schedule);
+  snapshot->fitness = fitness;
+  std::shared_ptr<const Snapshot> current = std::atomic_load(&snapshot_);
+  do {
+    if (current && current->fitness >= fitness)
+      return false;
+    snapshot->version = current ? current->version + 1 : 1;
+  } while (!std::atomic_compare_exchange_weak(
+      &snapshot_, &current, std::shared_ptr<const Snapshot>(snapshot)));
+
+  // Snapshots are swapped in the order of fitnesses, but stores to `best_fitness_` may be
+  // reordered between publishers, so it is only raised.
+  double best = best_fitness();
+  while (best < fitness && !best_fitness_.compare_exchange_weak(best, fitness)) {}
+  return true;
+}
+
+std::shared_ptr<const Incumbent::Snapshot> Incumbent::Get() const {
+  return std::atomic_load(&snapshot_);
+}
+
+void Incumbent::Reset() {
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>());
+  best_fitness_.store(-std::numeric_limits<double>::infinity());
+}
+
+}  // namespace lss
@@ -0,0 +1,53 @@
+// This header provides Incumbent - the best schedule found so far, shared by algorithms
+// which run concurrently (e.g. genetic islands or local search chains). Publishing and
+// reading never block each other: the best fitness is an atomic double, so that worse
+// schedules are rejected with a single load, and the schedule itself is an immutable,
+// versioned snapshot swapped with atomic operations on shared_ptr.
+
+#ifndef LSS_BASE_INCUMBENT_H_
+#define LSS_BASE_INCUMBENT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "base/schedule.h"
+
+namespace lss {
+
+class Incumbent {
+ public:
+  struct Snapshot {
+    Schedule schedule;
+    double fitness;
+    uint64_t version;  // Schedules published since the last Reset(), including this one.
+  };
+
+  Incumbent();
+
+  // Fitness of the current snapshot or -infinity if nothing was published.
+  // May be stale, so it can only be used to skip building schedules which are not better.
+  double best_fitness() const { return best_fitness_.load(std::memory_order_acquire); }
+
+  // Returns whether `fitness` was better than the current one and the schedule became
+  // the snapshot. Fitnesses must be ObjectiveFunction() of the schedules in the same
+  // situation, so that schedules published by different algorithms are comparable.
+  bool Publish(Schedule schedule, double fitness);
+
+  // Returns nullptr if nothing was published since construction or the last Reset().
+  std::shared_ptr<const Snapshot> Get() const;
+
+  // Forgets the snapshot, e.g. when the situation changes. Must not be called while
+  // schedules of the previous situation may still be published.
+  void Reset();
+
+ private:
+  std::atomic<double> best_fitness_;
+  // Accessed only with std::atomic_load(), std::atomic_store() and
+  // std::atomic_compare_exchange_weak().
+  std::shared_ptr<const Snapshot> snapshot_;
+};
+
+}  // namespace lss
+
+#endif  // LSS_BASE_INCUMBENT_H_
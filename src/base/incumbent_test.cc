@@ -0,0 +1,96 @@
+#include "base/incumbent.h"
+
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "base/raw_situation.h"
+
+namespace lss {
+namespace {
+
+const auto kSample = RawSituation()
+    .add(RawMachine().id(0))
+    .add(RawJob().id(0));
+
+class IncumbentTest : public ::testing::Test {
+ protected:
+  IncumbentTest() : situation_(kSample, false) {}
+
+  // Schedule with job 0 on machine 0 repeated `count` times, to tell schedules apart.
+  Schedule MakeSchedule(int count) {
+    Schedule schedule(situation_);
+    for (int i = 0; i < count; ++i)
+      schedule.AssignJob(situation_.machines()[0], situation_.jobs()[0]);
+    return schedule;
+  }
+
+  Situation situation_;
+  Incumbent incumbent_;
+};
+
+TEST_F(IncumbentTest, Empty) {
+  EXPECT_EQ(nullptr, incumbent_.Get());
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(), incumbent_.best_fitness());
+}
+
+// Verify that only better schedules replace the snapshot.
+TEST_F(IncumbentTest, PublishBetter) {
+  EXPECT_TRUE(incumbent_.Publish(MakeSchedule(1), 1.));
+  EXPECT_FALSE(incumbent_.Publish(MakeSchedule(2), 1.));
+  EXPECT_FALSE(incumbent_.Publish(MakeSchedule(3), 0.5));
+  EXPECT_TRUE(incumbent_.Publish(MakeSchedule(4), 2.));
+
+  auto snapshot = incumbent_.Get();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_EQ(2., snapshot->fitness);
+  EXPECT_EQ(2, snapshot->version);
+  EXPECT_EQ(4, snapshot->schedule.jobs(0).size());
+  EXPECT_EQ(2., incumbent_.best_fitness());
+}
+
+// Verify that readers keep their snapshots when newer ones are published.
+TEST_F(IncumbentTest, SnapshotsAreImmutable) {
+  incumbent_.Publish(MakeSchedule(1), 1.);
+  auto old_snapshot = incumbent_.Get();
+  incumbent_.Publish(MakeSchedule(2), 2.);
+  EXPECT_EQ(1, old_snapshot->schedule.jobs(0).size());
+  EXPECT_EQ(1, old_snapshot->version);
+}
+
+TEST_F(IncumbentTest, Reset) {
+  incumbent_.Publish(MakeSchedule(1), 1.);
+  incumbent_.Reset();
+  EXPECT_EQ(nullptr, incumbent_.Get());
+  EXPECT_TRUE(incumbent_.Publish(MakeSchedule(2), 0.));
+  EXPECT_EQ(1, incumbent_.Get()->version);
+}
+
+// Verify that the best of schedules published concurrently wins.
+TEST_F(IncumbentTest, ConcurrentPublish) {
+  const int kThreads = 4, kSchedules = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([this, t]() {
+      for (int i = 0; i < kSchedules; ++i) {
+        double fitness = (i * 7919 + t * 104729) % (kThreads * kSchedules);
+        incumbent_.Publish(MakeSchedule(t + 1), fitness);
+        ASSERT_NE(nullptr, incumbent_.Get());
+      }
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+
+  double best = -1;
+  for (int t = 0; t < kThreads; ++t)
+    for (int i = 0; i < kSchedules; ++i)
+      best = std::max<double>(best, (i * 7919 + t * 104729) % (kThreads * kSchedules));
+  EXPECT_EQ(best, incumbent_.Get()->fitness);
+  EXPECT_EQ(best, incumbent_.best_fitness());
+}
+
+}  // namespace
+}  // namespace lss
@@ -0,0 +1,81 @@
+#include "base/portfolio.h"
+
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace lss {
+
+PortfolioAlgorithm::PortfolioAlgorithm(std::vector<Entry> entries,
+                                       std::chrono::milliseconds budget)
+    : entries_(std::move(entries)), budget_(budget) {
+  if (entries_.empty()) throw std::invalid_argument("At least one algorithm is required.");
+  for (Entry &entry : entries_)
+    entry.algorithm->SetIncumbent(incumbent_);
+}
+
+Schedule PortfolioAlgorithm::Run(const Schedule &prev_schedule, Situation new_situation) {
+  incumbent_->Reset();
+  auto deadline = std::chrono::steady_clock::now() + budget_;
+  std::vector<Schedule> schedules(entries_.size());
+  std::vector<std::exception_ptr> errors(entries_.size());
+  std::vector<std::thread> threads;
+  // `new_situation` outlives the threads, so they never free the shared situation data.
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    entries_[i].algorithm->SetDeadline(deadline);
+    threads.emplace_back([&, i]() {
+      try {
+        schedules[i] = entries_[i].algorithm->Run(prev_schedule, new_situation);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+
+  double best_score = std::numeric_limits<double>::lowest();
+  size_t best = entries_.size();
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    if (errors[i]) {
+      try {
+        std::rethrow_exception(errors[i]);
+      } catch (const std::exception &e) {
+        LOG(ERROR) << "Portfolio algorithm " << entries_[i].name << " failed: " << e.what();
+      } catch (...) {
+        LOG(ERROR) << "Portfolio algorithm " << entries_[i].name << " failed";
+      }
+      continue;
+    }
+    double score = ObjectiveFunction(schedules[i], new_situation);
+    LOG(INFO) << "Portfolio algorithm " << entries_[i].name << " scored " << score;
+    if (best == entries_.size() || score > best_score) {
+      best_score = score;
+      best = i;
+    }
+  }
+
+  // Published fitnesses are ObjectiveFunction() scores, so they compare with `best_score`.
+  Schedule result;
+  auto snapshot = incumbent_->Get();
+  if (snapshot && (best == entries_.size() || snapshot->fitness > best_score)) {
+    last_winner_ = "incumbent";
+    best_score = snapshot->fitness;
+    result = snapshot->schedule;
+  } else if (best < entries_.size()) {
+    last_winner_ = entries_[best].name;
+    result = std::move(schedules[best]);
+  } else {
+    throw std::runtime_error("All portfolio algorithms failed.");
+  }
+  LOG(INFO) << "Portfolio winner: " << last_winner_ << " with score " << best_score;
+  if (Incumbent *incumbent = this->incumbent())
+    incumbent->Publish(result, best_score);
+  return result;
+}
+
+}  // namespace lss
@@ -0,0 +1,44 @@
+#ifndef LSS_BASE_PORTFOLIO_H_
+#define LSS_BASE_PORTFOLIO_H_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/algorithm.h"
+#include "base/incumbent.h"
+#include "base/schedule.h"
+#include "base/situation.h"
+
+namespace lss {
+
+// Runs several algorithms on separate threads against the same situation and returns
+// the schedule with the highest ObjectiveFunction(). Every Run() gives the algorithms
+// a deadline `budget` from its start and they share an incumbent, so the best schedule
+// found by any of them is kept even if it is not what the algorithm returns.
+class PortfolioAlgorithm : public Algorithm {
+ public:
+  struct Entry {
+    std::string name;
+    std::unique_ptr<Algorithm> algorithm;
+  };
+
+  PortfolioAlgorithm(std::vector<Entry> entries, std::chrono::milliseconds budget);
+
+  Schedule Run(const Schedule &prev_schedule, Situation new_situation) override;
+
+  // Name of the algorithm whose schedule was returned by the last Run() or "incumbent"
+  // if an intermediate schedule was better than all the returned ones.
+  const std::string &last_winner() const { return last_winner_; }
+
+ private:
+  std::vector<Entry> entries_;
+  std::chrono::milliseconds budget_;
+  std::shared_ptr<Incumbent> incumbent_ = std::make_shared<Incumbent>();
+  std::string last_winner_;
+};
+
+}  // namespace lss
+
+#endif  // LSS_BASE_PORTFOLIO_H_
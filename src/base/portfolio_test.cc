@@ -0,0 +1,109 @@
+#include "base/portfolio.h"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "base/algorithm_test_utils.h"
+#include "base/raw_situation.h"
+
+namespace lss {
+namespace {
+
+// Every job on machine 0 is worth 1.
+const auto kSample = RawSituation()
+    .add(RawMachine().id(0))
+    .add(RawMachineSet().id(0).add(0))
+    .add(RawAccount().id(0))
+    .add(RawBatch().id(0).account(0).job_reward(1).duration(1))
+    .add(RawJob().id(0).batch(0).machine_set(0).duration(1))
+    .add(RawJob().id(1).batch(0).machine_set(0).duration(1))
+    .add(RawJob().id(2).batch(0).machine_set(0).duration(1));
+
+// Runs until the deadline.
+class DeadlineAlgorithm : public Algorithm {
+ public:
+  Schedule Run(const Schedule &, Situation situation) override {
+    while (!DeadlinePassed()) {}
+    return Schedule(situation);
+  }
+};
+
+std::vector<PortfolioAlgorithm::Entry> Entries() {
+  return {};
+}
+
+template<class... Rest>
+std::vector<PortfolioAlgorithm::Entry> Entries(std::string name,
+                                               std::unique_ptr<Algorithm> algorithm,
+                                               Rest... rest) {
+  std::vector<PortfolioAlgorithm::Entry> entries = Entries(std::move(rest)...);
+  entries.insert(entries.begin(), {name, std::move(algorithm)});
+  return entries;
+}
+
+class PortfolioTest : public ::testing::Test {
+ protected:
+  PortfolioTest() : situation_(kSample, false) {}
+
+  Situation situation_;
+};
+
+TEST_F(PortfolioTest, ReturnsBestSchedule) {
+  PortfolioAlgorithm portfolio(
+      Entries("one", std::make_unique<AlgorithmFake>(1),
+              "three", std::make_unique<AlgorithmFake>(3),
+              "two", std::make_unique<AlgorithmFake>(2)),
+      std::chrono::milliseconds(100));
+  Schedule schedule = portfolio.Run(Schedule(), situation_);
+  EXPECT_EQ("three", portfolio.last_winner());
+  EXPECT_EQ(3, schedule.jobs(situation_.machines()[0]).size());
+}
+
+// Verify that a schedule published by an algorithm wins if it is better than the returned ones.
+TEST_F(PortfolioTest, ReturnsIncumbent) {
+  PortfolioAlgorithm portfolio(
+      Entries("one", std::make_unique<AlgorithmFake>(1, 3),
+              "two", std::make_unique<AlgorithmFake>(2)),
+      std::chrono::milliseconds(100));
+  Schedule schedule = portfolio.Run(Schedule(), situation_);
+  EXPECT_EQ("incumbent", portfolio.last_winner());
+  EXPECT_EQ(3, schedule.jobs(situation_.machines()[0]).size());
+
+  // The incumbent of the previous run is forgotten.
+  portfolio.Run(Schedule(), situation_);
+  EXPECT_EQ("incumbent", portfolio.last_winner());
+}
+
+TEST_F(PortfolioTest, IgnoresFailures) {
+  PortfolioAlgorithm portfolio(
+      Entries("failing", std::make_unique<FailingAlgorithm>(),
+              "one", std::make_unique<AlgorithmFake>(1)),
+      std::chrono::milliseconds(100));
+  portfolio.Run(Schedule(), situation_);
+  EXPECT_EQ("one", portfolio.last_winner());
+
+  PortfolioAlgorithm failing(Entries("failing", std::make_unique<FailingAlgorithm>()),
+                             std::chrono::milliseconds(100));
+  EXPECT_THROW(failing.Run(Schedule(), situation_), std::runtime_error);
+}
+
+TEST_F(PortfolioTest, StopsAtDeadline) {
+  PortfolioAlgorithm portfolio(
+      Entries("deadline", std::make_unique<DeadlineAlgorithm>(),
+              "one", std::make_unique<AlgorithmFake>(1)),
+      std::chrono::milliseconds(20));
+  auto start = std::chrono::steady_clock::now();
+  portfolio.Run(Schedule(), situation_);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+  EXPECT_EQ("one", portfolio.last_winner());
+}
+
+}  // namespace
+}  // namespace lss
@@ -2,35 +2,166 @@
 #define LSS_BASE_RANDOM_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
+#include <memory>
 #include <random>
+#include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
 
 namespace lss {
 
+// xoshiro256** by Blackman and Vigna: a fast generator with period 2^256 - 1 whose Jump()
+// splits it into 2^128 non-overlapping streams. Satisfies UniformRandomBitGenerator, so it can
+// be used with std distributions, and generates the same sequence on every platform.
+class Xoshiro256 {
+ public:
+  using result_type = uint64_t;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  // The state is initialized with splitmix64, as recommended by the authors.
+  explicit Xoshiro256(uint64_t seed = 0) {
+    for (uint64_t &s : s_)
+      s = SplitMix64(&seed);
+  }
+
+  result_type operator()() {
+    result_type result = Rotl(s_[1] * 5, 7) * 9;
+    result_type t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = Rotl(s_[3], 45);
+    return result;
+  }
+
+  // Advances the generator by 2^128 steps.
+  void Jump() {
+    static constexpr uint64_t kJump[] = {
+        0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+    uint64_t s[4] = {};
+    for (uint64_t jump : kJump) {
+      for (int bit = 0; bit < 64; ++bit) {
+        if (jump & (uint64_t(1) << bit)) {
+          for (int i = 0; i < 4; ++i)
+            s[i] ^= s_[i];
+        }
+        (*this)();
+      }
+    }
+    std::copy(s, s + 4, s_);
+  }
+
+  friend bool operator==(const Xoshiro256 &lhs, const Xoshiro256 &rhs) {
+    return std::equal(lhs.s_, lhs.s_ + 4, rhs.s_);
+  }
+
+ private:
+  static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+  static uint64_t SplitMix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t s_[4];
+};
+
+// Uniform distributions over Xoshiro256, the same on every platform (unlike std ones).
+// Methods are not virtual, so that statically composed algorithms can inline them.
+class FastRandom {
+ public:
+  explicit FastRandom(uint64_t seed) : engine_(seed) {}
+
+  // Returns a generator of the current stream and moves this one to the next stream,
+  // so that the streams of subsequent splits do not overlap.
+  FastRandom Split() {
+    FastRandom stream = *this;
+    engine_.Jump();
+    return stream;
+  }
+
+  Xoshiro256 &engine() { return engine_; }
+
+  double GetRealInRange(double from, double to) {
+    return from + (to - from) * ((engine_() >> 11) * (1. / (uint64_t(1) << 53)));
+  }
+
+  // Returns a number from [0, range), 0 if `range == 0`. Uses Lemire's multiply-shift
+  // reduction of a 64-bit number.
+  size_t Rand(size_t range) {
+    return static_cast<uint64_t>((static_cast<Uint128>(engine_()) * range) >> 64);
+  }
+
+  // Fisher-Yates shuffle.
+  template<class T>
+  void Shuffle(std::vector<T> *v) {
+    for (size_t i = v->size(); i > 1; --i)
+      std::swap((*v)[i - 1], (*v)[Rand(i)]);
+  }
+
+  void RandomShuffle(std::vector<size_t> *v) { Shuffle(v); }
+
+ private:
+  __extension__ using Uint128 = unsigned __int128;
+
+  Xoshiro256 engine_;
+};
+
+// Source of randomness of the genetic algorithm and greedy_new, with virtual methods so that
+// it can be mocked. Runs are reproducible given the seed. A single Random must not be shared
+// between threads; use Split() to get an independent stream for every thread instead.
 class Random {
  public:
-  Random() : gen_(std::random_device()()) {}
+  // Seeded from std::random_device; seed() allows replaying the run.
+  Random() : Random(std::random_device()()) {}
+  explicit Random(uint64_t seed) : seed_(seed), fast_(seed) {}
+  // Draws from `stream`, e.g. a FastRandom::Split() of a generator seeded with `seed`.
+  Random(uint64_t seed, FastRandom stream) : seed_(seed), fast_(stream) {}
+
+  uint64_t seed() const { return seed_; }
+
+  // See FastRandom::Split().
+  std::shared_ptr<Random> Split() {
+    auto stream = std::make_shared<Random>(*this);
+    fast_.engine().Jump();
+    return stream;
+  }
+
+  Xoshiro256 &engine() { return fast_.engine(); }
 
   virtual double GetRealInRange(double from, double to) {
-    std::uniform_real_distribution<> dist(from, to);
-    return dist(gen_);
+    return fast_.GetRealInRange(from, to);
   }
 
   virtual void RandomShuffle(std::vector<size_t> *v) {
-    std::random_shuffle(std::begin(*v), std::end(*v));
+    fast_.Shuffle(v);
   }
 
+  // Returns a number from [0, range), 0 if `range == 0`.
   virtual size_t Rand(size_t range) {
-    return std::rand() % range;
+    return fast_.Rand(range);
+  }
+
+  template<class T>
+  void Shuffle(std::vector<T> *v) {
+    fast_.Shuffle(v);
   }
 
   virtual ~Random() = default;
 
  private:
-  std::mt19937 gen_;
+  uint64_t seed_;
+  FastRandom fast_;
 };
 
 class RandomMock: public Random {
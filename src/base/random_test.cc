@@ -0,0 +1,89 @@
+#include "base/random.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace lss {
+namespace {
+
+std::vector<size_t> Sample(Random *random, int count) {
+  std::vector<size_t> result;
+  for (int i = 0; i < count; ++i)
+    result.push_back(random->Rand(1000000));
+  return result;
+}
+
+// Verify that runs are reproducible given the seed.
+TEST(RandomTest, Deterministic) {
+  Random r1(42), r2(42), r3(43);
+  EXPECT_EQ(42, r1.seed());
+  auto sample = Sample(&r1, 100);
+  EXPECT_EQ(sample, Sample(&r2, 100));
+  EXPECT_NE(sample, Sample(&r3, 100));
+}
+
+// Verify that a split stream starts where the parent was and the parent moves on.
+TEST(RandomTest, Split) {
+  Random parent(7), reference(7);
+  auto stream1 = parent.Split();
+  auto stream2 = parent.Split();
+  auto sample1 = Sample(stream1.get(), 100);
+  EXPECT_EQ(Sample(&reference, 100), sample1);
+  EXPECT_NE(sample1, Sample(stream2.get(), 100));
+  EXPECT_NE(sample1, Sample(&parent, 100));
+}
+
+// Verify that a Random built from a FastRandom stream draws from that stream.
+TEST(RandomTest, FromFastRandomStream) {
+  FastRandom parent(5);
+  parent.Split();
+  Random random(5, parent.Split());
+  FastRandom reference(5);
+  reference.Split();
+  EXPECT_EQ(5, random.seed());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(reference.Rand(1000000), random.Rand(1000000));
+}
+
+TEST(RandomTest, Ranges) {
+  Random random(0);
+  EXPECT_EQ(0, random.Rand(0));
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_LT(random.Rand(3), 3);
+    double real = random.GetRealInRange(-1., 2.);
+    EXPECT_LE(-1., real);
+    EXPECT_LT(real, 2.);
+  }
+}
+
+TEST(RandomTest, Shuffle) {
+  std::vector<size_t> v1(50), v2(50);
+  std::iota(v1.begin(), v1.end(), 0);
+  std::iota(v2.begin(), v2.end(), 0);
+  Random r1(3), r2(3);
+  r1.RandomShuffle(&v1);
+  r2.Shuffle(&v2);
+  EXPECT_EQ(v1, v2);
+  EXPECT_FALSE(std::is_sorted(v1.begin(), v1.end()));
+  std::sort(v1.begin(), v1.end());
+  for (size_t i = 0; i < v1.size(); ++i)
+    EXPECT_EQ(i, v1[i]);
+}
+
+TEST(RandomTest, Xoshiro256) {
+  Xoshiro256 engine(1), jumped(1);
+  jumped.Jump();
+  EXPECT_FALSE(engine == jumped);
+  std::uniform_int_distribution<int> dist(0, 9);
+  for (int i = 0; i < 100; ++i) {
+    int value = dist(engine);
+    EXPECT_LE(0, value);
+    EXPECT_LE(value, 9);
+  }
+}
+
+}  // namespace
+}  // namespace lss
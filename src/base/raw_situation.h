@@ -4,6 +4,7 @@
 #define LSS_BASE_RAW_SITUATION_H_
 
 #include <iostream>
+#include <utility>
 #include <vector>
 
 #include "base/types.h"
@@ -109,13 +110,13 @@ struct RawSituation {
   std::vector<RawChangeCost> change_costs_{};
 
   RawSituation& time_stamp(Time val) { time_stamp_ = val; return *this; }
-  RawSituation& add(RawMachine val) { machines_.push_back(val); return *this; }
-  RawSituation& add(RawMachineSet val) { machine_sets_.push_back(val); return *this; }
-  RawSituation& add(RawFairSet val) { fair_sets_.push_back(val); return *this; }
-  RawSituation& add(RawJob val) { jobs_.push_back(val); return *this; }
-  RawSituation& add(RawBatch val) { batches_.push_back(val); return *this; }
-  RawSituation& add(RawAccount val) { accounts_.push_back(val); return *this; }
-  RawSituation& add(RawChangeCost val) { change_costs_.push_back(val); return *this; }
+  RawSituation& add(RawMachine val) { machines_.push_back(std::move(val)); return *this; }
+  RawSituation& add(RawMachineSet val) { machine_sets_.push_back(std::move(val)); return *this; }
+  RawSituation& add(RawFairSet val) { fair_sets_.push_back(std::move(val)); return *this; }
+  RawSituation& add(RawJob val) { jobs_.push_back(std::move(val)); return *this; }
+  RawSituation& add(RawBatch val) { batches_.push_back(std::move(val)); return *this; }
+  RawSituation& add(RawAccount val) { accounts_.push_back(std::move(val)); return *this; }
+  RawSituation& add(RawChangeCost val) { change_costs_.push_back(std::move(val)); return *this; }
 };
 
 }  // namespace lss
@@ -1,14 +1,16 @@
 #include "base/schedule.h"
 
 #include <algorithm>
-#include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <set>
 #include <unordered_set>
 
 #include "glog/logging.h"
 
+#include "base/imbalance.h"
+#include "base/sigmoid.h"
 #include "base/situation.h"
 
 namespace lss {
@@ -17,7 +19,7 @@ namespace {
 using JobFinishTime = std::unordered_map<Job, Time>;
 
 double Sigmoid(double reward, double timely_reward, Time time) {
-  return reward + timely_reward / (1 + exp(time));
+  return reward + timely_reward * ::lss::Sigmoid(time);
 }
 
 Time NormalizeTime(Batch batch, Time time) {
@@ -33,23 +35,24 @@ double BatchReward(Batch batch, Time time) {
   return Sigmoid(batch.reward(), batch.timely_reward(), NormalizeTime(batch, time));
 }
 
-double ChangeCost(const Situation &situation, Job from, Job to) {
-  return situation.change_costs().cost(from.context(), to.context());
-}
-
+// Adds jobs to `imbalance` unless it is null.
 double JobsIngredient(const Schedule &schedule,
                       Situation situation,
-                      JobFinishTime *job_finish_time) {
+                      JobFinishTime *job_finish_time,
+                      ImbalanceEvaluator *imbalance) {
   double result = 0.;
-  for (const auto &assignment : schedule.GetAssignments()) {
-    Time time = situation.time_stamp();
-    auto jobs = assignment.second;
-    for (size_t i = 0; i < jobs.size(); ++i) {
-      Job job = jobs[i];
-      double change_cost = (i ? ChangeCost(situation, jobs[i - 1], job) : 0);
-      time += job.duration() + change_cost;
+  for (size_t queue = 0; queue < schedule.queue_count(); ++queue) {
+    Machine machine = schedule.machine(queue);
+    Time time = machine ? machine.free_time() : situation.time_stamp();
+    // The first job is set up after the running job (see ChangeCosts::setup_cost()).
+    Context context = machine ? machine.last_context() : Context();
+    for (Job job : schedule.jobs(queue)) {
+      time += job.duration() + situation.change_costs().setup_cost(context, job.context());
+      context = job.context();
       (*job_finish_time)[job] = time;
       result += JobReward(job, time);
+      if (imbalance)
+        imbalance->AddJob(machine, job, time - job.duration(), time);
     }
   }
   return result;
@@ -58,13 +61,13 @@ double JobsIngredient(const Schedule &schedule,
 double BatchIngredient(Situation situation, const JobFinishTime &job_finish_time) {
   double result = 0.;
   for (Batch batch : situation.batches()) {
-    Time batch_finish_time = std::numeric_limits<Time>::min();
+    Time batch_finish_time = std::numeric_limits<Time>::lowest();
     for (Job job : batch.jobs()) {
       if (job_finish_time.count(job)) {
         batch_finish_time = std::max(batch_finish_time, job_finish_time.at(job));
       }
     }
-    if (batch_finish_time != std::numeric_limits<int>::min()) {
+    if (batch_finish_time != std::numeric_limits<Time>::lowest()) {
       result += BatchReward(batch, batch_finish_time);
     }
   }
@@ -73,10 +76,81 @@ double BatchIngredient(Situation situation, const JobFinishTime &job_finish_time
 
 }  // namespace
 
-double ObjectiveFunction(const Schedule &schedule, Situation situation) {
+Schedule::Schedule(Situation situation)
+    : situation_(situation), queue_index_(situation.machines().size(), -1) {
+  for (Machine m : situation.machines()) {
+    if (m.alive()) AddQueue(m);
+  }
+}
+
+void Schedule::AssignJob(Machine machine, Job job) {
+  int index = FindQueue(machine);
+  if (index < 0)
+    index = AddQueue(machine);
+  Queue &queue = queues_[index];
+  if (queue.size == queue.capacity) {
+    // Queues at the end of the buffer grow in place, the other ones are moved to its end.
+    size_t capacity = std::max<size_t>(2 * queue.capacity, 4);
+    if (queue.begin + queue.capacity != jobs_.size()) {
+      size_t begin = jobs_.size();
+      jobs_.resize(begin + capacity);
+      std::copy(jobs_.begin() + queue.begin, jobs_.begin() + queue.begin + queue.size,
+                jobs_.begin() + begin);
+      queue.begin = begin;
+    } else {
+      jobs_.resize(queue.begin + capacity);
+    }
+    queue.capacity = capacity;
+  }
+  jobs_[queue.begin + queue.size++] = job;
+}
+
+Schedule::JobSpan Schedule::jobs(Machine machine) const {
+  int index = FindQueue(machine);
+  return index < 0 ? JobSpan() : jobs(index);
+}
+
+Schedule::Assignments Schedule::GetAssignments() const {
+  Assignments assignments;
+  for (size_t queue = 0; queue < queues_.size(); ++queue) {
+    JobSpan span = jobs(queue);
+    assignments[queues_[queue].machine] = Jobs(span.begin(), span.end());
+  }
+  return assignments;
+}
+
+bool Schedule::InSituation(Machine machine) const {
+  return machine && machine.index() < queue_index_.size() &&
+      situation_.machines()[machine.index()] == machine;
+}
+
+int Schedule::FindQueue(Machine machine) const {
+  if (InSituation(machine))
+    return queue_index_[machine.index()];
+  auto it = other_queue_index_.find(machine);
+  return it == other_queue_index_.end() ? -1 : it->second;
+}
+
+int Schedule::AddQueue(Machine machine) {
+  int index = queues_.size();
+  queues_.push_back({machine, jobs_.size(), 0, 0});
+  if (InSituation(machine))
+    queue_index_[machine.index()] = index;
+  else
+    other_queue_index_[machine] = index;
+  return index;
+}
+
+double ObjectiveFunction(const Schedule &schedule, Situation situation,
+                         double imbalance_factor) {
   JobFinishTime job_finish_time;
-  double result = JobsIngredient(schedule, situation, &job_finish_time);
+  std::unique_ptr<ImbalanceEvaluator> imbalance;
+  if (imbalance_factor != 0.)
+    imbalance = std::make_unique<ImbalanceEvaluator>(situation);
+  double result = JobsIngredient(schedule, situation, &job_finish_time, imbalance.get());
   result += BatchIngredient(situation, job_finish_time);
+  if (imbalance)
+    result -= imbalance_factor * imbalance->Compute();
   return result;
 }
 
@@ -12,34 +12,77 @@ namespace lss {
 
 // Simple interface needed by genetic algorithm.
 // Can be extended in the future.
+//
+// Queues of all machines are stored in a single buffer of jobs, each of them as a contiguous
+// span, and machines of the situation are found by Machine::index() without hashing
+// (other ones, e.g. of a default-constructed Schedule, through a hash map).
+// Queues are kept in the order in which they were created: alive machines of the situation
+// in the order of ids first.
 class Schedule {
  public:
   using Jobs = std::vector<Job>;
   using Assignments = std::unordered_map<Machine, Jobs>;
 
+  // Jobs of a single queue. Invalidated by AssignJob().
+  class JobSpan {
+   public:
+    JobSpan() = default;
+    JobSpan(const Job *begin, size_t size) : begin_(begin), size_(size) {}
+
+    const Job *begin() const { return begin_; }
+    const Job *end() const { return begin_ + size_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    Job operator[](size_t i) const { return begin_[i]; }
+
+   private:
+    const Job *begin_ = nullptr;
+    size_t size_ = 0;
+  };
+
   Schedule() = default;
 
-  explicit Schedule(Situation situation) {
-    for (Machine m : situation.machines()) {
-      schedule_[m] = {};
-    }
-  }
+  // Creates empty queues for machines which are alive.
+  explicit Schedule(Situation situation);
 
   // Does not check whether machine is valid
   // or job can be executed on a given machine.
-  void AssignJob(Machine machine, Job job) {
-    schedule_[machine].push_back(job);
-  }
+  void AssignJob(Machine machine, Job job);
 
-  const Assignments &GetAssignments() const {
-    return schedule_;
+  size_t queue_count() const { return queues_.size(); }
+  Machine machine(size_t queue) const { return queues_[queue].machine; }
+  JobSpan jobs(size_t queue) const {
+    return JobSpan(jobs_.data() + queues_[queue].begin, queues_[queue].size);
   }
 
+  // Returns an empty span if there is no queue of `machine`.
+  JobSpan jobs(Machine machine) const;
+
+  // Compatibility view which copies all queues into a map.
+  Assignments GetAssignments() const;
+
  private:
-  Assignments schedule_;
+  struct Queue {
+    Machine machine;
+    size_t begin, size, capacity;
+  };
+
+  bool InSituation(Machine machine) const;
+  // Returns -1 if there is no queue of `machine`.
+  int FindQueue(Machine machine) const;
+  int AddQueue(Machine machine);
+
+  Situation situation_;
+  std::vector<int> queue_index_;  // Per machine of the situation, -1 if there is no queue.
+  std::unordered_map<Machine, int> other_queue_index_;  // Machines outside the situation.
+  std::vector<Queue> queues_;
+  std::vector<Job> jobs_;
 };
 
-double ObjectiveFunction(const Schedule &schedule, Situation situation);
+// Sum of job and batch rewards minus `imbalance_factor` times the fair-share
+// imbalance (see ImbalanceEvaluator) of `schedule`.
+double ObjectiveFunction(const Schedule &schedule, Situation situation,
+                         double imbalance_factor = 0.);
 
 }  // namespace lss
 
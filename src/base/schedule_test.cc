@@ -0,0 +1,103 @@
+#include "base/schedule.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "base/raw_situation.h"
+
+namespace lss {
+namespace {
+
+// Machine 1 is dead, so it has no queue until a job is assigned to it.
+const auto kSample = RawSituation()
+    .add(RawMachine().id(2).state(MachineState::kIdle))
+    .add(RawMachine().id(0).state(MachineState::kIdle))
+    .add(RawMachine().id(1).state(MachineState::kDead))
+    .add(RawJob().id(0))
+    .add(RawJob().id(1))
+    .add(RawJob().id(2))
+    .add(RawJob().id(3))
+    .add(RawJob().id(4));
+
+class ScheduleTest : public ::testing::Test {
+ protected:
+  ScheduleTest() : situation_(kSample, false) {}
+
+  Machine machine(IdType id) { return situation_[Id<Machine>(id)]; }
+  Job job(IdType id) { return situation_[Id<Job>(id)]; }
+
+  std::vector<Job> Jobs(Schedule::JobSpan span) {
+    return std::vector<Job>(span.begin(), span.end());
+  }
+
+  Situation situation_;
+};
+
+TEST_F(ScheduleTest, MachineIndex) {
+  for (size_t i = 0; i < situation_.machines().size(); ++i)
+    EXPECT_EQ(i, situation_.machines()[i].index());
+}
+
+// Verify that alive machines of the situation have queues in the order of ids.
+TEST_F(ScheduleTest, QueuesOfAliveMachines) {
+  Schedule schedule(situation_);
+  ASSERT_EQ(2, schedule.queue_count());
+  EXPECT_EQ(machine(0), schedule.machine(0));
+  EXPECT_EQ(machine(2), schedule.machine(1));
+  EXPECT_TRUE(schedule.jobs(0).empty());
+  EXPECT_TRUE(schedule.jobs(machine(1)).empty());
+}
+
+// Verify that interleaved assignments keep the order of jobs of every machine.
+TEST_F(ScheduleTest, InterleavedAssignments) {
+  Schedule schedule(situation_);
+  std::vector<Job> expected0, expected2;
+  for (int i = 0; i < 20; ++i) {
+    schedule.AssignJob(machine(i % 3 ? 0 : 2), job(i % 5));
+    (i % 3 ? expected0 : expected2).push_back(job(i % 5));
+  }
+  EXPECT_EQ(expected0, Jobs(schedule.jobs(machine(0))));
+  EXPECT_EQ(expected2, Jobs(schedule.jobs(machine(2))));
+  EXPECT_EQ(expected0, Jobs(schedule.jobs(0)));
+
+  Schedule copy = schedule;
+  EXPECT_EQ(expected2, Jobs(copy.jobs(machine(2))));
+}
+
+// Verify that dead machines and machines outside the situation get queues after
+// the initial ones.
+TEST_F(ScheduleTest, AdditionalQueues) {
+  Schedule schedule(situation_);
+  schedule.AssignJob(Machine(), job(0));
+  schedule.AssignJob(machine(1), job(1));
+  schedule.AssignJob(Machine(), job(2));
+  ASSERT_EQ(4, schedule.queue_count());
+  EXPECT_EQ(Machine(), schedule.machine(2));
+  EXPECT_EQ(std::vector<Job>({job(0), job(2)}), Jobs(schedule.jobs(Machine())));
+  EXPECT_EQ(machine(1), schedule.machine(3));
+  EXPECT_EQ(std::vector<Job>({job(1)}), Jobs(schedule.jobs(machine(1))));
+
+  Schedule without_situation;
+  without_situation.AssignJob(machine(0), job(3));
+  without_situation.AssignJob(machine(2), job(4));
+  without_situation.AssignJob(machine(0), job(1));
+  ASSERT_EQ(2, without_situation.queue_count());
+  EXPECT_EQ(std::vector<Job>({job(3), job(1)}), Jobs(without_situation.jobs(machine(0))));
+  EXPECT_EQ(std::vector<Job>({job(4)}), Jobs(without_situation.jobs(machine(2))));
+  EXPECT_TRUE(without_situation.jobs(machine(1)).empty());
+}
+
+TEST_F(ScheduleTest, GetAssignments) {
+  Schedule schedule(situation_);
+  schedule.AssignJob(machine(2), job(1));
+  schedule.AssignJob(machine(2), job(0));
+  Schedule::Assignments expected = {
+      {machine(0), {}},
+      {machine(2), {job(1), job(0)}},
+  };
+  EXPECT_EQ(expected, schedule.GetAssignments());
+}
+
+}  // namespace
+}  // namespace lss
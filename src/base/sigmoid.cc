@@ -0,0 +1,12 @@
+#include "base/sigmoid.h"
+
+namespace lss {
+
+// This file is compiled with flags which allow vectorization of the loop below
+// (see CMakeLists.txt).
+void Sigmoid(const double *__restrict x, double *__restrict out, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = Sigmoid(x[i]);
+}
+
+}  // namespace lss
@@ -0,0 +1,83 @@
+// This header provides the sigmoid 1 / (1 + exp(x)) used by all objective function
+// evaluations, together with a fast approximation of it. Define LSS_FAST_SIGMOID
+// (CMake option of the same name) to make Sigmoid() use the approximation.
+
+#ifndef LSS_BASE_SIGMOID_H_
+#define LSS_BASE_SIGMOID_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace lss {
+
+// Maximum relative error of FastExp() and maximum absolute error of FastSigmoid().
+static constexpr double kFastExpMaxError = 1e-8;
+
+// FastExp() of `x` in [-708, 709], which is not checked.
+inline double FastExpInRange(double x) {
+  static constexpr double kLog2e = 1.4426950408889634;
+  static constexpr double kLn2Hi = 6.93145751953125e-1;
+  static constexpr double kLn2Lo = 1.42860682030941723212e-6;
+  // Adding this constant rounds to an integer which ends up in low bits of the mantissa.
+  static constexpr double kRoundingBias = 6755399441055744.0;  // 1.5 * 2^52
+
+  double biased = x * kLog2e + kRoundingBias;
+  double k = biased - kRoundingBias;
+  double r = (x - k * kLn2Hi) - k * kLn2Lo;
+
+  double p = 1. / 40320;
+  p = p * r + 1. / 5040;
+  p = p * r + 1. / 720;
+  p = p * r + 1. / 120;
+  p = p * r + 1. / 24;
+  p = p * r + 1. / 6;
+  p = p * r + 1. / 2;
+  p = p * r + 1.;
+  p = p * r + 1.;
+
+  int64_t biased_bits, bias_bits;
+  std::memcpy(&biased_bits, &biased, sizeof(biased));
+  std::memcpy(&bias_bits, &kRoundingBias, sizeof(kRoundingBias));
+  int64_t scale_bits = (biased_bits - bias_bits + 1023) << 52;
+  double scale;
+  std::memcpy(&scale, &scale_bits, sizeof(scale));
+  return p * scale;
+}
+
+// Computes exp(x) as 2^k * exp(r), where k = round(x / ln 2) and |r| <= ln(2) / 2, using
+// a degree 8 Taylor polynomial for exp(r). Arguments are clamped to [-708, 709] so that
+// the result is always a normal number. There are no branches, so loops over arrays
+// of arguments can be vectorized.
+inline double FastExp(double x) {
+  return FastExpInRange(std::min(std::max(x, -708.), 709.));
+}
+
+inline double ExactSigmoid(double x) {
+  return 1 / (1 + std::exp(x));
+}
+
+// Arguments are clamped to [-708, 700], so that results (and their products with rewards)
+// are never subnormal; arithmetic with subnormal numbers is very slow, even in lanes whose
+// results are discarded. The error due to clamping is far below kFastExpMaxError.
+inline double FastSigmoid(double x) {
+  return 1 / (1 + FastExpInRange(std::min(std::max(x, -708.), 700.)));
+}
+
+inline double Sigmoid(double x) {
+#ifdef LSS_FAST_SIGMOID
+  return FastSigmoid(x);
+#else
+  return ExactSigmoid(x);
+#endif
+}
+
+// Computes `out[i] = Sigmoid(x[i])` for `i < n`. The arrays must not overlap.
+// With LSS_FAST_SIGMOID the loop is vectorized.
+void Sigmoid(const double *x, double *out, size_t n);
+
+}  // namespace lss
+
+#endif  // LSS_BASE_SIGMOID_H_
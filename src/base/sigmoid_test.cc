@@ -0,0 +1,43 @@
+#include "base/sigmoid.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace lss {
+namespace {
+
+// Verify the relative error bound of FastExp() on the whole range of normal results.
+TEST(SigmoidTest, FastExpError) {
+  for (double x = -708; x <= 709; x += 0.0137) {
+    double exact = std::exp(x);
+    ASSERT_LE(std::abs(FastExp(x) - exact), kFastExpMaxError * exact) << "x = " << x;
+  }
+}
+
+TEST(SigmoidTest, FastExpExtremeArguments) {
+  EXPECT_TRUE(std::isfinite(FastExp(1e6)));
+  EXPECT_GT(FastExp(1e6), 0);
+  EXPECT_GE(FastExp(-1e6), 0);
+  EXPECT_LT(FastExp(-1e6), 1e-300);
+  EXPECT_DOUBLE_EQ(1, FastExp(0));
+}
+
+// Verify the absolute error bound of FastSigmoid(), including arguments which are
+// clamped by FastExp().
+TEST(SigmoidTest, FastSigmoidError) {
+  for (double x = -1000; x <= 1000; x += 0.0113)
+    ASSERT_NEAR(ExactSigmoid(x), FastSigmoid(x), kFastExpMaxError) << "x = " << x;
+}
+
+TEST(SigmoidTest, Array) {
+  std::vector<double> x{-5, -0.5, 0, 0.5, 5};
+  std::vector<double> out(x.size());
+  Sigmoid(x.data(), out.data(), x.size());
+  for (size_t i = 0; i < x.size(); ++i)
+    EXPECT_DOUBLE_EQ(Sigmoid(x[i]), out[i]);
+}
+
+}  // namespace
+}  // namespace lss
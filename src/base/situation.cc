@@ -92,6 +92,24 @@ Situation::Situation(const RawSituation &raw, BuildMode mode)
   for (auto b : data_->batches_)
     Sort(&b.data_->jobs);
   // Only single relations in Job, so no loop for it.
+
+  // Derived properties, so that algorithms do not consider infeasible placements.
+  for (size_t i = 0; i < data_->machines_.size(); ++i)
+    data_->machines_[i].data_->index = i;
+  for (auto m : data_->machines_) {
+    m.data_->free_time = data_->time_stamp_;
+    if (Job running = m.job())
+      m.data_->free_time = std::max(m.data_->free_time, running.start_time() + running.duration());
+  }
+  for (size_t i = 0; i < data_->machine_sets_.size(); ++i) {
+    MachineSet s = data_->machine_sets_[i];
+    s.data_->index = i;
+    s.data_->bitmap = Bitmap(data_->machines_.size());
+    for (Machine m : s.machines()) {
+      if (m.alive()) s.data_->alive_machines.push_back(m);
+      s.data_->bitmap.Set(m.index());
+    }
+  }
 }
 
 Situation::Situation(const RawSituation &raw, bool safe)
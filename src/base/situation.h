@@ -10,6 +10,7 @@
 #include <memory>
 #include <vector>
 
+#include "base/bitmap.h"
 #include "base/raw_situation.h"
 #include "base/types.h"
 
@@ -36,6 +37,10 @@ class Machine {
   MachineSets machine_sets() const;  // Backward relation
   FairSet fair_set() const;          // Backward relation
   Job job() const;                   // Backward relation; extra; optional
+  bool alive() const;                // Derived; state is not kDead
+  Time free_time() const;            // Derived; estimated end of the running job or time stamp
+  Context last_context() const;      // Derived; context of the running job or the machine
+  size_t index() const;              // Derived; position in Situation::machines()
 
   friend bool operator==(const Machine &lhs, const Machine &rhs) { return lhs.data_ == rhs.data_; }
 
@@ -55,9 +60,13 @@ class MachineSet {
   MachineSet() = default;
   explicit operator bool() { return data_ != nullptr; }
 
-  Id<MachineSet> id() const;  // Property
-  Machines machines() const;  // Forward relation
-  Jobs jobs() const;          // Backward relation
+  Id<MachineSet> id() const;        // Property
+  Machines machines() const;        // Forward relation
+  Machines alive_machines() const;  // Derived; machines which are alive()
+  Jobs jobs() const;                // Backward relation
+  size_t index() const;             // Derived; position in Situation::machine_sets()
+  const Bitmap &bitmap() const;     // Derived; Machine::index() of machines()
+  bool contains(Machine m) const;   // Derived; single bit test, false for null Machine
 
   friend bool operator==(const MachineSet &lhs, const MachineSet &rhs) {
     return lhs.data_ == rhs.data_;
@@ -166,6 +175,14 @@ class ChangeCosts {
  public:
   Cost cost(Change c) const { return cost_[static_cast<size_t>(c)]; }
   Cost cost(Context from, Context to) const { return cost(Change(from, to)); }
+  // Cost of the setup of a machine which was in context `from` before a job in context `to`.
+  // Components of `from` equal to `Context::kNone` (unknown) are not considered changed.
+  Cost setup_cost(Context from, Context to) const {
+    Change change(from, to);
+    for (int i = 0; i < Context::kSize; ++i)
+      if (from[i] == Context::kNone) change[i] = false;
+    return cost(change);
+  }
 
  private:
   ChangeCosts(const ChangeCosts &) = delete;
@@ -285,13 +302,20 @@ struct Machine::Data {
   std::vector<MachineSet> machine_sets;
   FairSet fair_set;
   Job job;
+
+  Time free_time;
+  size_t index;
 };
 
 struct MachineSet::Data {
   Id<MachineSet> id;
 
   std::vector<Machine> machines;
+  std::vector<Machine> alive_machines;
   std::vector<Job> jobs;
+
+  size_t index;
+  Bitmap bitmap;
 };
 
 struct FairSet::Data {
@@ -346,10 +370,19 @@ inline Context Machine::context() const {return data_->context; }
 inline Machine::MachineSets Machine::machine_sets() const { return data_->machine_sets; }
 inline FairSet Machine::fair_set() const { return data_->fair_set; }
 inline Job Machine::job() const { return data_->job; }
+inline bool Machine::alive() const { return data_->state != MachineState::kDead; }
+inline Time Machine::free_time() const { return data_->free_time; }
+inline size_t Machine::index() const { return data_->index; }
 
 inline Id<MachineSet> MachineSet::id() const { return data_->id; }
 inline MachineSet::Machines MachineSet::machines() const { return data_->machines; }
+inline MachineSet::Machines MachineSet::alive_machines() const {
+  return data_->alive_machines;
+}
 inline MachineSet::Jobs MachineSet::jobs() const { return data_->jobs; }
+inline size_t MachineSet::index() const { return data_->index; }
+inline const Bitmap &MachineSet::bitmap() const { return data_->bitmap; }
+inline bool MachineSet::contains(Machine m) const { return m && data_->bitmap.Test(m.index()); }
 
 inline Id<FairSet> FairSet::id() const { return data_->id; }
 inline FairSet::Machines FairSet::machines() const { return data_->machines; }
@@ -376,6 +409,10 @@ inline Machine Job::machine() const { return data_->machine; }
 inline MachineSet Job::machine_set() const { return data_->machine_set; }
 inline Batch Job::batch() const { return data_->batch; }
 
+inline Context Machine::last_context() const {
+  return data_->job ? data_->job.context() : data_->context;
+}
+
 template<class T>
 T Situation::Get(const std::vector<T> &from, Id<T> id) {
   if (!id)
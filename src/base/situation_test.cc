@@ -444,5 +444,38 @@ TEST(SituationTest, OverlappingFairSets) {
   EXPECT_EQ(machine, machine.fair_set().machines().front());
 }
 
+// Verify that derived machine availability takes machine states and running jobs into account.
+TEST(SituationTest, MachineAvailability) {
+  Situation s{sample};
+  auto machine = [&s](IdType id) { return s[Id<Machine>(id)]; };
+  EXPECT_TRUE(machine(2).alive());
+  EXPECT_TRUE(machine(6).alive());
+  EXPECT_FALSE(machine(10).alive());
+
+  EXPECT_EQ(41 + 37, machine(2).free_time());
+  EXPECT_EQ(1, machine(6).free_time());
+
+  auto alive = s[Id<MachineSet>(14)].alive_machines();
+  ASSERT_EQ(2, alive.size());
+  EXPECT_EQ(machine(2), alive[0]);
+  EXPECT_EQ(machine(6), alive[1]);
+  alive = s[Id<MachineSet>(15)].alive_machines();
+  ASSERT_EQ(1, alive.size());
+  EXPECT_EQ(machine(6), alive[0]);
+}
+
+// Verify that bitmaps of machine sets agree with their machines.
+TEST(SituationTest, MachineSetBitmaps) {
+  Situation s{sample};
+  for (size_t i = 0; i < s.machine_sets().size(); ++i) {
+    MachineSet set = s.machine_sets()[i];
+    EXPECT_EQ(i, set.index());
+    EXPECT_EQ(set.machines().size(), set.bitmap().Count());
+    for (Machine m : s.machines())
+      EXPECT_EQ(Contains(m, set.machines()), set.contains(m));
+  }
+  EXPECT_FALSE(s.machine_sets().front().contains(Machine()));
+}
+
 }  // namespace
 }  // namespace lss
@@ -0,0 +1,194 @@
+// This header provides SortedIdMap - a map from ids (e.g. Id<Job>) to values stored in
+// a vector sorted by ids, so that it can be swept together with other sequences sorted by
+// ids (e.g. records of a RawSituation) in linear time and without allocations.
+//
+// Values of keys which are already in the vector are updated and erased in place (erased
+// entries stay as tombstones). New keys are appended to a short unsorted log instead, which
+// is merged into the vector once it is longer than the square root of the vector, so that
+// insertions cost amortized O(sqrt(n)) rather than O(n). Buffers are reused, so there are
+// no allocations once the map has reached its size.
+
+#ifndef LSS_BASE_SORTED_ID_MAP_H_
+#define LSS_BASE_SORTED_ID_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace lss {
+
+template<class K, class V>
+class SortedIdMap {
+ public:
+  // Returns nullptr if there is no value for `key`.
+  const V *Find(K key) const {
+    for (size_t i = log_.size(); i-- > 0;) {
+      if (log_[i].key == key)
+        return &log_[i].value;
+    }
+    auto entry = LowerBound(key);
+    return entry != sorted_.end() && entry->key == key && entry->present ? &entry->value
+                                                                         : nullptr;
+  }
+
+  V *Find(K key) {
+    return const_cast<V *>(static_cast<const SortedIdMap *>(this)->Find(key));
+  }
+
+  bool Contains(K key) const { return Find(key) != nullptr; }
+
+  // Returns the value of `key`, inserting a default one if there is none.
+  V &operator[](K key) {
+    if (V *value = Find(key))
+      return *value;
+    auto entry = LowerBound(key);
+    if (entry != sorted_.end() && entry->key == key) {
+      // A tombstone.
+      --tombstones_;
+      entry->present = true;
+      entry->value = V();
+      return entry->value;
+    }
+    if (log_.size() >= kMinLogSize && log_.size() * log_.size() >= sorted_.size())
+      Merge();
+    log_.push_back(Entry{key, V(), true});
+    return log_.back().value;
+  }
+
+  void Erase(K key) {
+    for (size_t i = 0; i < log_.size(); ++i) {
+      if (log_[i].key == key) {
+        log_[i] = log_.back();
+        log_.pop_back();
+        return;
+      }
+    }
+    auto entry = LowerBound(key);
+    if (entry != sorted_.end() && entry->key == key && entry->present) {
+      entry->present = false;
+      if (++tombstones_ * 2 > sorted_.size())
+        Merge();
+    }
+  }
+
+  void Clear() {
+    sorted_.clear();
+    log_.clear();
+    tombstones_ = 0;
+  }
+
+  // Calls `visit(key, value)` for all entries in order of keys.
+  template<class F>
+  void ForEach(F visit) {
+    Merge();
+    for (Entry &entry : sorted_)
+      visit(entry.key, entry.value);
+  }
+
+  // Calls `visit(key, value)` for all entries in no particular order.
+  template<class F>
+  void ForEachUnordered(F visit) const {
+    for (const Entry &entry : sorted_) {
+      if (entry.present)
+        visit(entry.key, entry.value);
+    }
+    for (const Entry &entry : log_)
+      visit(entry.key, entry.value);
+  }
+
+  // Erases entries for which `erase(key, value)` returns true. The function is called for all
+  // entries in order of keys, and it must not access the map.
+  template<class F>
+  void EraseIf(F erase) {
+    Merge();
+    size_t kept = 0;
+    for (size_t i = 0; i < sorted_.size(); ++i) {
+      if (!erase(sorted_[i].key, sorted_[i].value)) {
+        if (kept != i)
+          sorted_[kept] = std::move(sorted_[i]);
+        ++kept;
+      }
+    }
+    sorted_.resize(kept);
+  }
+
+ private:
+  static constexpr size_t kMinLogSize = 16;
+
+  struct Entry {
+    K key;
+    V value;
+    bool present;
+  };
+
+  typename std::vector<Entry>::const_iterator LowerBound(K key) const {
+    return std::lower_bound(sorted_.begin(), sorted_.end(), key,
+                            [](const Entry &entry, K key) { return entry.key < key; });
+  }
+
+  typename std::vector<Entry>::iterator LowerBound(K key) {
+    return std::lower_bound(sorted_.begin(), sorted_.end(), key,
+                            [](const Entry &entry, K key) { return entry.key < key; });
+  }
+
+  // Merges the log into the sorted vector and drops tombstones.
+  void Merge() {
+    if (log_.empty() && tombstones_ == 0)
+      return;
+    std::sort(log_.begin(), log_.end(),
+              [](const Entry &lhs, const Entry &rhs) { return lhs.key < rhs.key; });
+    merged_.clear();
+    auto logged = log_.begin();
+    for (Entry &entry : sorted_) {
+      if (!entry.present)
+        continue;
+      for (; logged != log_.end() && logged->key < entry.key; ++logged)
+        merged_.push_back(std::move(*logged));
+      merged_.push_back(std::move(entry));
+    }
+    for (; logged != log_.end(); ++logged)
+      merged_.push_back(std::move(*logged));
+    sorted_.swap(merged_);
+    log_.clear();
+    tombstones_ = 0;
+  }
+
+  std::vector<Entry> sorted_;  // Sorted by keys, disjoint with the log.
+  std::vector<Entry> log_;     // New keys, not sorted.
+  std::vector<Entry> merged_;  // Buffer for merging.
+  size_t tombstones_ = 0;      // Entries of the sorted vector which are not present.
+};
+
+// Set of ids, see SortedIdMap.
+template<class K>
+class SortedIdSet {
+ public:
+  bool Contains(K key) const { return map_.Contains(key); }
+  void Insert(K key) { map_[key]; }
+  void Erase(K key) { map_.Erase(key); }
+  void Clear() { map_.Clear(); }
+
+  template<class F>
+  void ForEach(F visit) {
+    map_.ForEach([&visit](K key, Empty) { visit(key); });
+  }
+
+  template<class F>
+  void ForEachUnordered(F visit) const {
+    map_.ForEachUnordered([&visit](K key, Empty) { visit(key); });
+  }
+
+  template<class F>
+  void EraseIf(F erase) {
+    map_.EraseIf([&erase](K key, Empty) { return erase(key); });
+  }
+
+ private:
+  struct Empty {};
+
+  SortedIdMap<K, Empty> map_;
+};
+
+}  // namespace lss
+
+#endif  // LSS_BASE_SORTED_ID_MAP_H_
@@ -0,0 +1,99 @@
+#include "base/sorted_id_map.h"
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "base/situation.h"
+#include "base/types.h"
+
+namespace lss {
+namespace {
+
+using Map = SortedIdMap<Id<Job>, int>;
+
+std::vector<std::pair<Id<Job>, int>> Entries(Map *map) {
+  std::vector<std::pair<Id<Job>, int>> entries;
+  map->ForEach([&entries](Id<Job> key, int value) { entries.emplace_back(key, value); });
+  return entries;
+}
+
+TEST(SortedIdMapTest, FindsInsertedValues) {
+  Map map;
+  EXPECT_EQ(nullptr, map.Find(Id<Job>(1)));
+  map[Id<Job>(2)] = 20;
+  map[Id<Job>(1)] = 10;
+  ASSERT_NE(nullptr, map.Find(Id<Job>(1)));
+  EXPECT_EQ(10, *map.Find(Id<Job>(1)));
+  EXPECT_EQ(20, map[Id<Job>(2)]);
+  EXPECT_FALSE(map.Contains(Id<Job>(3)));
+}
+
+TEST(SortedIdMapTest, VisitsEntriesInOrderOfKeys) {
+  Map map;
+  // Enough keys to merge the log a few times.
+  for (int i = 0; i < 1000; ++i)
+    map[Id<Job>((i * 7919) % 1000)] = i;
+  map.Erase(Id<Job>(500));
+  map.Erase(Id<Job>(1000));
+  map[Id<Job>(5)] = -5;
+
+  std::vector<std::pair<Id<Job>, int>> entries = Entries(&map);
+  ASSERT_EQ(999, entries.size());
+  for (size_t i = 1; i < entries.size(); ++i)
+    EXPECT_LT(entries[i - 1].first, entries[i].first);
+  EXPECT_EQ(-5, entries[5].second);
+  EXPECT_FALSE(map.Contains(Id<Job>(500)));
+}
+
+TEST(SortedIdMapTest, ErasesAndInsertsAgain) {
+  Map map;
+  for (int i = 0; i < 100; ++i)
+    map[Id<Job>(i)] = i;
+  Entries(&map);
+  // Erased both from the sorted vector and from the log.
+  map.Erase(Id<Job>(10));
+  map[Id<Job>(200)] = 200;
+  map.Erase(Id<Job>(200));
+  EXPECT_FALSE(map.Contains(Id<Job>(10)));
+  EXPECT_FALSE(map.Contains(Id<Job>(200)));
+  EXPECT_EQ(99, Entries(&map).size());
+
+  map[Id<Job>(10)] = 1;
+  EXPECT_EQ(1, *map.Find(Id<Job>(10)));
+  for (int i = 0; i < 100; ++i)
+    map.Erase(Id<Job>(i));
+  EXPECT_TRUE(Entries(&map).empty());
+}
+
+TEST(SortedIdMapTest, ErasesIfPredicateHolds) {
+  Map map;
+  for (int i = 0; i < 50; ++i)
+    map[Id<Job>(49 - i)] = i;
+  std::vector<Id<Job>> visited;
+  map.EraseIf([&visited](Id<Job> key, int) {
+    visited.push_back(key);
+    return static_cast<IdType>(key) % 2 == 1;
+  });
+  ASSERT_EQ(50, visited.size());
+  EXPECT_EQ(Id<Job>(0), visited.front());
+  EXPECT_EQ(Id<Job>(49), visited.back());
+  EXPECT_EQ(25, Entries(&map).size());
+  EXPECT_TRUE(map.Contains(Id<Job>(48)));
+  EXPECT_FALSE(map.Contains(Id<Job>(49)));
+}
+
+TEST(SortedIdSetTest, InsertsAndErases) {
+  SortedIdSet<Id<Job>> set;
+  set.Insert(Id<Job>(3));
+  set.Insert(Id<Job>(1));
+  set.Insert(Id<Job>(3));
+  set.Erase(Id<Job>(1));
+  std::vector<Id<Job>> keys;
+  set.ForEachUnordered([&keys](Id<Job> key) { keys.push_back(key); });
+  EXPECT_EQ(std::vector<Id<Job>>({Id<Job>(3)}), keys);
+}
+
+}  // namespace
+}  // namespace lss
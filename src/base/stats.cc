@@ -0,0 +1,143 @@
+#include "base/stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "glog/logging.h"
+
+namespace lss {
+namespace {
+
+constexpr const char *kPhaseNames[kNumPhases] = {
+    "read", "adjust_raw_situation", "build_situation", "run", "adjust_assignments",
+};
+
+constexpr const char *kStatCounterNames[kNumStatCounters] = {
+    "cycles", "jobs", "machines", "assignments_attempted", "assignments_failed", "syscalls",
+};
+
+// log2 of the number of buckets per power of two.
+constexpr int kSubBucketBits = 2;
+constexpr int kSubBuckets = 1 << kSubBucketBits;
+
+}  // namespace
+
+const char *PhaseName(Phase phase) {
+  return kPhaseNames[static_cast<size_t>(phase)];
+}
+
+const char *StatCounterName(StatCounter counter) {
+  return kStatCounterNames[static_cast<size_t>(counter)];
+}
+
+// Values below kSubBuckets have their own buckets. Larger values with the highest bit
+// at position e fall into one of the kSubBuckets buckets covering [2^e, 2^(e+1)).
+size_t LatencyHistogram::Bucket(int64_t nanos) {
+  if (nanos < kSubBuckets)
+    return std::max<int64_t>(nanos, 0);
+  int e = 63 - __builtin_clzll(nanos);
+  int sub = (nanos >> (e - kSubBucketBits)) & (kSubBuckets - 1);
+  return (e - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+int64_t LatencyHistogram::BucketUpperBound(size_t bucket) {
+  if (bucket < kSubBuckets)
+    return bucket;
+  int e = bucket / kSubBuckets + kSubBucketBits - 1;
+  int64_t sub = bucket % kSubBuckets;
+  int64_t width = int64_t{1} << (e - kSubBucketBits);
+  return (kSubBuckets + sub) * width + width - 1;
+}
+
+void LatencyHistogram::Record(int64_t nanos) {
+  ++buckets_[Bucket(nanos)];
+  ++count_;
+  max_ = std::max(max_, nanos);
+}
+
+int64_t LatencyHistogram::Percentile(double p) const {
+  if (count_ == 0)
+    return 0;
+  size_t rank = std::max<size_t>(std::ceil(p / 100 * count_), 1);
+  size_t seen = 0;
+  for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+    seen += buckets_[bucket];
+    if (seen >= rank)
+      return std::min(BucketUpperBound(bucket), max_);
+  }
+  return max_;
+}
+
+Stats &Stats::Global() {
+  static Stats stats;
+  return stats;
+}
+
+void Stats::Reset() {
+  for (LatencyHistogram &h : histograms_)
+    h.Reset();
+  counters_.fill(0);
+}
+
+void Stats::Dump(std::ostream *output) const {
+  for (size_t i = 0; i < kNumPhases; ++i) {
+    const LatencyHistogram &h = histograms_[i];
+    *output << kPhaseNames[i] << ".count " << h.count() << '\n'
+        << kPhaseNames[i] << ".p50_ns " << h.Percentile(50) << '\n'
+        << kPhaseNames[i] << ".p99_ns " << h.Percentile(99) << '\n'
+        << kPhaseNames[i] << ".max_ns " << h.max() << '\n';
+  }
+  for (size_t i = 0; i < kNumStatCounters; ++i)
+    *output << kStatCounterNames[i] << ' ' << counters_[i] << '\n';
+}
+
+void Stats::Log() const {
+  for (size_t i = 0; i < kNumPhases; ++i) {
+    const LatencyHistogram &h = histograms_[i];
+    LOG(INFO) << "Phase " << kPhaseNames[i] << ": count " << h.count()
+        << ", p50 " << h.Percentile(50) / 1000 << "us"
+        << ", p99 " << h.Percentile(99) / 1000 << "us"
+        << ", max " << h.max() / 1000 << "us";
+  }
+  std::ostringstream counters;
+  for (size_t i = 0; i < kNumStatCounters; ++i)
+    counters << (i ? ", " : "") << kStatCounterNames[i] << ' ' << counters_[i];
+  LOG(INFO) << "Counters: " << counters.str();
+}
+
+ScopedTimer::~ScopedTimer() {
+  auto elapsed = std::chrono::steady_clock::now() - start_;
+  Stats::Global().Record(phase_,
+                         std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+StatsDumper::StatsDumper(const std::string &path, std::chrono::seconds interval)
+    : path_(path), interval_(interval), last_dump_(std::chrono::steady_clock::now()) {}
+
+void StatsDumper::Tick() {
+  auto now = std::chrono::steady_clock::now();
+  if (now - last_dump_ < interval_)
+    return;
+  last_dump_ = now;
+  Dump();
+}
+
+void StatsDumper::Dump() {
+  Stats &stats = Stats::Global();
+  stats.Log();
+  if (!path_.empty()) {
+    // Written to a temporary file first, so that readers never see a partial dump.
+    const std::string tmp_path = path_ + "_tmp";
+    {
+      std::ofstream output(tmp_path);
+      stats.Dump(&output);
+    }
+    PLOG_IF(WARNING, std::rename(tmp_path.c_str(), path_.c_str())) << "Writing stats failed";
+  }
+  stats.Reset();
+}
+
+}  // namespace lss
@@ -0,0 +1,138 @@
+// This header provides latency histograms and counters of the main scheduling loop.
+// Code should record them with the LSS_STATS_* macros, which compile to nothing
+// unless LSS_STATS (CMake option of the same name) is defined.
+
+#ifndef LSS_BASE_STATS_H_
+#define LSS_BASE_STATS_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace lss {
+
+enum class Phase {
+  kRead,
+  kAdjustRawSituation,
+  kBuildSituation,
+  kRun,
+  kAdjustAssignments,
+};
+
+enum class StatCounter {
+  kCycles,
+  kJobs,
+  kMachines,
+  kAssignmentsAttempted,
+  kAssignmentsFailed,
+  kSyscalls,  // Explicit file system calls (open, access, rename, ...) made by io.
+};
+
+static constexpr size_t kNumPhases = 5;
+static constexpr size_t kNumStatCounters = 6;
+
+const char *PhaseName(Phase phase);
+const char *StatCounterName(StatCounter counter);
+
+// Histogram of durations in nanoseconds with buckets growing exponentially,
+// four per power of two, so percentiles are accurate up to 25%.
+class LatencyHistogram {
+ public:
+  void Record(int64_t nanos);
+  void Reset() { *this = LatencyHistogram(); }
+
+  size_t count() const { return count_; }
+  int64_t max() const { return max_; }
+
+  // Returns the upper bound of the bucket containing the `p`-th percentile,
+  // or 0 if there are no samples. `p` must be in [0, 100].
+  int64_t Percentile(double p) const;
+
+ private:
+  static constexpr size_t kNumBuckets = 256;
+
+  static size_t Bucket(int64_t nanos);
+  static int64_t BucketUpperBound(size_t bucket);
+
+  std::array<size_t, kNumBuckets> buckets_{};
+  size_t count_ = 0;
+  int64_t max_ = 0;
+};
+
+// Histograms and counters since the last Reset(). Not thread-safe; only the main
+// loop and the code it calls directly should record statistics.
+class Stats {
+ public:
+  // The instance used by the LSS_STATS_* macros.
+  static Stats &Global();
+
+  void Record(Phase phase, int64_t nanos) { histograms_[static_cast<size_t>(phase)].Record(nanos); }
+  void Add(StatCounter counter, int64_t n) { counters_[static_cast<size_t>(counter)] += n; }
+  void Reset();
+
+  const LatencyHistogram &histogram(Phase phase) const {
+    return histograms_[static_cast<size_t>(phase)];
+  }
+  int64_t counter(StatCounter counter) const { return counters_[static_cast<size_t>(counter)]; }
+
+  // Writes one "<key> <value>" line per statistic, e.g. "run.p99_ns 1200".
+  void Dump(std::ostream *output) const;
+
+  // Logs one line per phase and one line with all counters to glog.
+  void Log() const;
+
+ private:
+  std::array<LatencyHistogram, kNumPhases> histograms_;
+  std::array<int64_t, kNumStatCounters> counters_{};
+};
+
+// Records the time between construction and destruction in `Stats::Global()`.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Phase phase) : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedTimer();
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+ private:
+  Phase phase_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// Every `interval` logs `Stats::Global()`, overwrites the file at `path` (if not empty)
+// with its dump and resets it, so that each dump covers a single interval.
+class StatsDumper {
+ public:
+  StatsDumper(const std::string &path, std::chrono::seconds interval);
+
+  // Dumps if at least `interval` passed since the last dump.
+  void Tick();
+
+ private:
+  void Dump();
+
+  const std::string path_;
+  const std::chrono::seconds interval_;
+  std::chrono::steady_clock::time_point last_dump_;
+};
+
+}  // namespace lss
+
+#ifdef LSS_STATS
+#define LSS_STATS_CONCAT_(a, b) a##b
+#define LSS_STATS_CONCAT(a, b) LSS_STATS_CONCAT_(a, b)
+#define LSS_STATS_SCOPED_TIMER(phase) \
+    ::lss::ScopedTimer LSS_STATS_CONCAT(lss_scoped_timer_, __LINE__)(phase)
+#define LSS_STATS_ADD(counter, n) ::lss::Stats::Global().Add(counter, n)
+#define LSS_STATS_TICK(dumper) (dumper).Tick()
+#else
+#define LSS_STATS_SCOPED_TIMER(phase) do {} while (0)
+#define LSS_STATS_ADD(counter, n) do {} while (0)
+#define LSS_STATS_TICK(dumper) do {} while (0)
+#endif
+
+#endif  // LSS_BASE_STATS_H_
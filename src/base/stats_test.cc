@@ -0,0 +1,66 @@
+#include "base/stats.h"
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace lss {
+namespace {
+
+TEST(LatencyHistogramTest, Empty) {
+  LatencyHistogram h;
+  EXPECT_EQ(0, h.count());
+  EXPECT_EQ(0, h.max());
+  EXPECT_EQ(0, h.Percentile(50));
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram h;
+  for (int64_t v : {0, 1, 2, 3})
+    h.Record(v);
+  EXPECT_EQ(4, h.count());
+  EXPECT_EQ(1, h.Percentile(50));
+  EXPECT_EQ(3, h.Percentile(100));
+}
+
+// Verify that percentiles are within the 25% bucket accuracy.
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram h;
+  for (int64_t v = 1; v <= 100000; ++v)
+    h.Record(v);
+  EXPECT_EQ(100000, h.max());
+  EXPECT_GE(h.Percentile(50), 50000);
+  EXPECT_LE(h.Percentile(50), 50000 * 1.25);
+  EXPECT_GE(h.Percentile(99), 99000);
+  EXPECT_LE(h.Percentile(99), 100000);
+  EXPECT_EQ(100000, h.Percentile(100));
+}
+
+TEST(LatencyHistogramTest, LargeValues) {
+  LatencyHistogram h;
+  h.Record(int64_t{1} << 62);
+  EXPECT_EQ(int64_t{1} << 62, h.Percentile(50));
+}
+
+TEST(StatsTest, DumpAndReset) {
+  Stats stats;
+  stats.Record(Phase::kRun, 1000);
+  stats.Add(StatCounter::kSyscalls, 3);
+  stats.Add(StatCounter::kSyscalls, 2);
+
+  std::ostringstream output;
+  stats.Dump(&output);
+  std::string dump = output.str();
+  EXPECT_NE(std::string::npos, dump.find("run.count 1\n"));
+  EXPECT_NE(std::string::npos, dump.find("run.max_ns 1000\n"));
+  EXPECT_NE(std::string::npos, dump.find("read.count 0\n"));
+  EXPECT_NE(std::string::npos, dump.find("syscalls 5\n"));
+
+  stats.Reset();
+  EXPECT_EQ(0, stats.histogram(Phase::kRun).count());
+  EXPECT_EQ(0, stats.counter(StatCounter::kSyscalls));
+}
+
+}  // namespace
+}  // namespace lss
@@ -0,0 +1,85 @@
+#include "base/trace.h"
+
+#include <cmath>
+
+namespace lss {
+namespace {
+
+// Writes `value`, or `none` if it is NaN.
+void WriteValue(std::ostream *output, double value, const char *none) {
+  if (std::isnan(value))
+    *output << none;
+  else
+    *output << value;
+}
+
+}  // namespace
+
+constexpr double TracePoint::kNone;
+
+void Trace::Add(const TracePoint &point) {
+  if (capacity_ == 0)
+    return;
+  if (points_.size() < capacity_) {
+    points_.push_back(point);
+  } else {
+    points_[next_] = point;
+    ++dropped_;
+  }
+  next_ = (next_ + 1) % capacity_;
+}
+
+void Trace::Clear() {
+  points_.clear();
+  next_ = 0;
+  dropped_ = 0;
+}
+
+std::vector<TracePoint> Trace::Points() const {
+  if (points_.size() < capacity_)
+    return points_;
+  std::vector<TracePoint> points(points_.begin() + next_, points_.end());
+  points.insert(points.end(), points_.begin(), points_.begin() + next_);
+  return points;
+}
+
+void CsvTraceSink::Flush(const std::string &algorithm, int64_t run, const Trace &trace) {
+  if (!header_written_) {
+    *output_ << "algorithm,run,step,best,current,acceptance_rate,diversity,nanos\n";
+    header_written_ = true;
+  }
+  for (const TracePoint &p : trace.Points()) {
+    *output_ << algorithm << ',' << run << ',' << p.step << ',';
+    WriteValue(output_, p.best, "");
+    *output_ << ',';
+    WriteValue(output_, p.current, "");
+    *output_ << ',';
+    WriteValue(output_, p.acceptance_rate, "");
+    *output_ << ',';
+    WriteValue(output_, p.diversity, "");
+    *output_ << ',' << p.nanos << '\n';
+  }
+  output_->flush();
+}
+
+void JsonTraceSink::Flush(const std::string &algorithm, int64_t run, const Trace &trace) {
+  *output_ << "{\"algorithm\":\"" << algorithm << "\",\"run\":" << run
+      << ",\"dropped\":" << trace.dropped() << ",\"points\":[";
+  bool first = true;
+  for (const TracePoint &p : trace.Points()) {
+    *output_ << (first ? "" : ",") << "{\"step\":" << p.step << ",\"best\":";
+    WriteValue(output_, p.best, "null");
+    *output_ << ",\"current\":";
+    WriteValue(output_, p.current, "null");
+    *output_ << ",\"acceptance_rate\":";
+    WriteValue(output_, p.acceptance_rate, "null");
+    *output_ << ",\"diversity\":";
+    WriteValue(output_, p.diversity, "null");
+    *output_ << ",\"nanos\":" << p.nanos << '}';
+    first = false;
+  }
+  *output_ << "]}\n";
+  output_->flush();
+}
+
+}  // namespace lss
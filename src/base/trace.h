@@ -0,0 +1,89 @@
+#ifndef LSS_BASE_TRACE_H_
+#define LSS_BASE_TRACE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+namespace lss {
+
+// Progress of a search algorithm after a generation or a number of iterations.
+// Fields which do not apply to an algorithm are NaN.
+struct TracePoint {
+  static constexpr double kNone = std::numeric_limits<double>::quiet_NaN();
+
+  int64_t step = 0;               // Generation or iteration.
+  double best = kNone;            // Best evaluation so far.
+  double current = kNone;         // Evaluation of the current state or mean population fitness.
+  double acceptance_rate = kNone;  // Fraction of applied moves accepted since the last point.
+  double diversity = kNone;       // Standard deviation of population fitness.
+  int64_t nanos = 0;              // Time spent since the last point.
+};
+
+// Ring buffer keeping the last `capacity` points.
+class Trace {
+ public:
+  explicit Trace(size_t capacity) : capacity_(capacity) {}
+
+  void Add(const TracePoint &point);
+  void Clear();
+
+  // Returns the kept points, oldest first.
+  std::vector<TracePoint> Points() const;
+  // The number of points overwritten since the last Clear().
+  size_t dropped() const { return dropped_; }
+
+ private:
+  size_t capacity_;
+  std::vector<TracePoint> points_;
+  size_t next_ = 0;
+  size_t dropped_ = 0;
+};
+
+class TraceSink {
+ public:
+  // Called at the end of every Algorithm::Run() with points recorded during it.
+  // `run` counts Run() calls of the algorithm from 0.
+  virtual void Flush(const std::string &algorithm, int64_t run, const Trace &trace) = 0;
+
+  virtual ~TraceSink() = default;
+};
+
+class TraceSinkMock : public TraceSink {
+ public:
+  MOCK_METHOD3(Flush, void(const std::string &, int64_t, const Trace &));
+};
+
+// Writes a header and then one line per point:
+// "algorithm,run,step,best,current,acceptance_rate,diversity,nanos".
+class CsvTraceSink : public TraceSink {
+ public:
+  explicit CsvTraceSink(std::ostream *output) : output_(output) {}
+
+  void Flush(const std::string &algorithm, int64_t run, const Trace &trace) override;
+
+ private:
+  std::ostream *output_;
+  bool header_written_ = false;
+};
+
+// Writes one JSON object per Run() and line, with points in the "points" array.
+// NaN fields are written as null.
+class JsonTraceSink : public TraceSink {
+ public:
+  explicit JsonTraceSink(std::ostream *output) : output_(output) {}
+
+  void Flush(const std::string &algorithm, int64_t run, const Trace &trace) override;
+
+ private:
+  std::ostream *output_;
+};
+
+}  // namespace lss
+
+#endif  // LSS_BASE_TRACE_H_
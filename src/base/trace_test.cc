@@ -0,0 +1,79 @@
+#include "base/trace.h"
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace lss {
+namespace {
+
+TracePoint Point(int64_t step) {
+  TracePoint point;
+  point.step = step;
+  return point;
+}
+
+// Verify that only the last `capacity` points are kept, oldest first.
+TEST(TraceTest, RingBuffer) {
+  Trace trace(3);
+  for (int step = 0; step < 5; ++step)
+    trace.Add(Point(step));
+  auto points = trace.Points();
+  ASSERT_EQ(3, points.size());
+  EXPECT_EQ(2, points[0].step);
+  EXPECT_EQ(3, points[1].step);
+  EXPECT_EQ(4, points[2].step);
+  EXPECT_EQ(2, trace.dropped());
+
+  trace.Clear();
+  EXPECT_TRUE(trace.Points().empty());
+  EXPECT_EQ(0, trace.dropped());
+  trace.Add(Point(7));
+  ASSERT_EQ(1, trace.Points().size());
+  EXPECT_EQ(7, trace.Points()[0].step);
+}
+
+TEST(TraceTest, ZeroCapacity) {
+  Trace trace(0);
+  trace.Add(Point(0));
+  EXPECT_TRUE(trace.Points().empty());
+}
+
+TEST(TraceTest, Csv) {
+  Trace trace(10);
+  TracePoint point = Point(3);
+  point.best = 2.5;
+  point.nanos = 100;
+  trace.Add(point);
+
+  std::ostringstream output;
+  CsvTraceSink sink(&output);
+  sink.Flush("genetic", 0, trace);
+  sink.Flush("genetic", 1, trace);
+  EXPECT_EQ("algorithm,run,step,best,current,acceptance_rate,diversity,nanos\n"
+            "genetic,0,3,2.5,,,,100\n"
+            "genetic,1,3,2.5,,,,100\n",
+            output.str());
+}
+
+TEST(TraceTest, Json) {
+  Trace trace(10);
+  TracePoint point = Point(3);
+  point.best = 2.5;
+  point.acceptance_rate = 0.5;
+  trace.Add(point);
+  trace.Add(Point(4));
+
+  std::ostringstream output;
+  JsonTraceSink(&output).Flush("local_search", 2, trace);
+  EXPECT_EQ("{\"algorithm\":\"local_search\",\"run\":2,\"dropped\":0,\"points\":["
+            "{\"step\":3,\"best\":2.5,\"current\":null,\"acceptance_rate\":0.5,"
+            "\"diversity\":null,\"nanos\":0},"
+            "{\"step\":4,\"best\":null,\"current\":null,\"acceptance_rate\":null,"
+            "\"diversity\":null,\"nanos\":0}]}\n",
+            output.str());
+}
+
+}  // namespace
+}  // namespace lss
@@ -0,0 +1,115 @@
+#include <memory>
+
+#include "benchmark/benchmark.h"
+
+#include "base/algorithm.h"
+#include "base/schedule.h"
+#include "base/situation.h"
+#include "benchmarks/allocation_counter.h"
+#include "benchmarks/situation_generator.h"
+#include "genetic/algorithm.h"
+#include "genetic/permutation_chromosome/batch_evaluator.h"
+#include "genetic/permutation_chromosome/moves_impl.h"
+#include "genetic/selector_impl.h"
+#include "genetic/static_algorithm.h"
+#include "greedy_new/algorithm.h"
+#include "local_search/algorithm.h"
+
+namespace lss {
+namespace benchmarks {
+namespace {
+
+// Fixed amounts of work per Run(), so that the results measure the cost of
+// a single step at the given size rather than convergence.
+const int kLocalSearchIterations = 10000;
+const int kPopulationSize = 10;
+const int kGenerations = 5;
+
+std::unique_ptr<Algorithm> BuildGeneticAlgorithm() {
+  using genetic::PermutationJobMachine;
+
+  auto rand = std::make_shared<Random>();
+  auto evaluator = std::make_shared<genetic::BatchEvaluator>();
+  auto moves = std::make_shared<genetic::ConfigurableMoves<PermutationJobMachine>>();
+  (*moves)
+      .SetInitializer(std::make_shared<genetic::InitializerImpl>(rand))
+      .SetSelector(std::make_shared<genetic::SelectorImpl<PermutationJobMachine>>(evaluator, rand))
+      .SetCrosser(std::make_shared<genetic::CrosserImpl>(rand))
+      .SetMutator(std::make_shared<genetic::MutatorImpl>(0.01, rand));
+  return std::make_unique<genetic::GeneticAlgorithm<PermutationJobMachine>>(
+      kPopulationSize, kGenerations, 0.1, moves, rand);
+}
+
+// The same moves as BuildGeneticAlgorithm() composed statically.
+std::unique_ptr<Algorithm> BuildStaticGeneticAlgorithm() {
+  using genetic::PermutationJobMachine;
+  using Selector =
+      genetic::StaticSelector<PermutationJobMachine, genetic::BatchEvaluator, FastRandom>;
+
+  FastRandom rand(0);
+  return std::make_unique<genetic::StaticGeneticAlgorithm<
+      PermutationJobMachine, genetic::InitializerImpl, Selector,
+      genetic::StaticCrosser<FastRandom>, genetic::StaticMutator<FastRandom>, FastRandom>>(
+      kPopulationSize, kGenerations, 0.1,
+      genetic::InitializerImpl(std::make_shared<Random>(0, rand.Split())),
+      Selector(genetic::BatchEvaluator(), rand.Split()),
+      genetic::StaticCrosser<FastRandom>(rand.Split()),
+      genetic::StaticMutator<FastRandom>(0.01, rand.Split()),
+      rand.Split());
+}
+
+std::unique_ptr<Algorithm> BuildLocalSearchAlgorithm() {
+  return std::make_unique<local_search::LocalSearchAlgorithm>(
+      kLocalSearchIterations, 0, std::make_shared<local_search::HillClimbing>(),
+      std::vector<std::shared_ptr<local_search::Move>>{
+          std::make_shared<local_search::RelocateMove>(),
+          std::make_shared<local_search::SwapMove>(),
+          std::make_shared<local_search::BlockMove>(),
+          std::make_shared<local_search::ReverseMove>()});
+}
+
+std::unique_ptr<Algorithm> BuildGreedyAlgorithm() {
+  return std::make_unique<greedy_new::GreedyAlgorithm>();
+}
+
+template<std::unique_ptr<Algorithm> (*Build)()>
+void BM_AlgorithmRun(benchmark::State &state) {
+  Situation situation(GenerateRawSituation(GeneratorParams::ForJobs(state.range(0))));
+  auto algorithm = Build();
+  Schedule schedule;
+  AllocationCounter allocations(&state);
+  for (auto _ : state) {
+    allocations.Start();
+    schedule = algorithm->Run(schedule, situation);
+    allocations.Stop();
+  }
+  state.SetItemsProcessed(state.iterations() * situation.jobs().size());
+}
+
+// Large sizes take minutes for the genetic algorithm; use --benchmark_filter to skip them.
+void JobCounts(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+// Machine sets of thousands of machines: 1M jobs on 50k machines at the largest size.
+void BM_GreedyManyMachines(benchmark::State &state) {
+  GeneratorParams params = GeneratorParams::ForJobs(state.range(0));
+  params.machines = state.range(0) / 20;
+  params.machine_sets = 10;
+  Situation situation(GenerateRawSituation(params));
+  greedy_new::GreedyAlgorithm algorithm;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithm.Run(Schedule(), situation));
+  state.SetItemsProcessed(state.iterations() * situation.jobs().size());
+}
+
+BENCHMARK(BM_GreedyManyMachines)
+    ->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_AlgorithmRun, BuildGreedyAlgorithm)->Apply(JobCounts);
+BENCHMARK_TEMPLATE(BM_AlgorithmRun, BuildLocalSearchAlgorithm)->Apply(JobCounts);
+BENCHMARK_TEMPLATE(BM_AlgorithmRun, BuildGeneticAlgorithm)->Apply(JobCounts);
+BENCHMARK_TEMPLATE(BM_AlgorithmRun, BuildStaticGeneticAlgorithm)->Apply(JobCounts);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace lss
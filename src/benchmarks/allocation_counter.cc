@@ -0,0 +1,40 @@
+#include "benchmarks/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+}  // namespace
+
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+namespace lss {
+namespace benchmarks {
+
+size_t AllocationCount() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+AllocationCounter::~AllocationCounter() {
+  state_->counters["allocs"] = benchmark::Counter(total_, benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace benchmarks
+}  // namespace lss
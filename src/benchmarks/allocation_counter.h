@@ -0,0 +1,34 @@
+#ifndef LSS_BENCHMARKS_ALLOCATION_COUNTER_H_
+#define LSS_BENCHMARKS_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+#include "benchmark/benchmark.h"
+
+namespace lss {
+namespace benchmarks {
+
+// The number of calls to the global operator new so far. The operator is replaced
+// in allocation_counter.cc for the whole benchmarks executable.
+size_t AllocationCount();
+
+// Counts allocations made inside Start() ... Stop() sections and reports their
+// average per iteration as the "allocs" counter of the benchmark.
+class AllocationCounter {
+ public:
+  explicit AllocationCounter(benchmark::State *state) : state_(state) {}
+  ~AllocationCounter();
+
+  void Start() { start_ = AllocationCount(); }
+  void Stop() { total_ += AllocationCount() - start_; }
+
+ private:
+  benchmark::State *state_;
+  size_t start_ = 0;
+  size_t total_ = 0;
+};
+
+}  // namespace benchmarks
+}  // namespace lss
+
+#endif  // LSS_BENCHMARKS_ALLOCATION_COUNTER_H_
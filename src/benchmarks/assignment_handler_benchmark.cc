@@ -0,0 +1,58 @@
+#include "benchmark/benchmark.h"
+
+#include "base/raw_situation.h"
+#include "benchmarks/allocation_counter.h"
+#include "benchmarks/situation_generator.h"
+#include "io/assignment_handler.h"
+
+namespace lss {
+namespace benchmarks {
+namespace {
+
+// Jobs assigned to machines with even ids are taken, the others stay pending.
+class HalfTakingWriter : public io::Writer {
+ public:
+  bool Assign(IdType, IdType) override { return true; }
+  bool Unassign(IdType) override { return true; }
+  bool DoesAssignmentExist(IdType machine_id) override { return machine_id % 2; }
+};
+
+void JobCounts(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+// Every machine has a pending assignment of a job, half of which are taken in the first
+// cycle. So later cycles sweep taken jobs which are still in the input, as with a driver
+// which lags behind.
+void BM_AdjustRawSituation(benchmark::State &state) {
+  RawSituation raw = GenerateRawSituation(GeneratorParams::ForJobs(state.range(0)));
+  io::AssignmentsSnapshot snapshot;
+  for (size_t i = 0; i < raw.machines_.size() && i < raw.jobs_.size(); ++i) {
+    Id<Machine> machine_id(raw.machines_[i].id_);
+    snapshot.assignments.emplace_back(machine_id, Id<Job>(raw.jobs_[i].id_));
+    snapshot.next_contexts.emplace_back(machine_id, raw.jobs_[i].context_);
+  }
+  HalfTakingWriter writer;
+  io::AssignmentsHandler handler(&writer);
+  handler.Restore(snapshot);
+  RawSituation first = raw;
+  handler.AdjustRawSituation(&first);
+
+  AllocationCounter allocations(&state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    RawSituation adjusted = raw;
+    state.ResumeTiming();
+
+    allocations.Start();
+    handler.AdjustRawSituation(&adjusted);
+    allocations.Stop();
+    benchmark::DoNotOptimize(adjusted.jobs_.data());
+  }
+  state.SetItemsProcessed(state.iterations() * raw.jobs_.size());
+}
+BENCHMARK(BM_AdjustRawSituation)->Apply(JobCounts);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace lss
@@ -0,0 +1,48 @@
+#include <memory>
+
+#include "benchmark/benchmark.h"
+
+#include "base/situation.h"
+#include "benchmarks/situation_generator.h"
+#include "genetic/permutation_chromosome/batch_evaluator.h"
+#include "genetic/permutation_chromosome/moves_impl.h"
+
+namespace lss {
+namespace genetic {
+namespace {
+
+const int kPopulationSize = 64;
+
+void RunEvaluator(benchmark::State &state, const Evaluator<PermutationJobMachine> &evaluator) {
+  auto params = benchmarks::GeneratorParams::ForJobs(state.range(0));
+  params.machines = state.range(1);
+  Situation situation(benchmarks::GenerateRawSituation(params));
+  auto population = InitializerImpl(std::make_shared<Random>())
+      .InitPopulation(situation, kPopulationSize);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(evaluator.EvaluateAll(situation, population));
+  state.SetItemsProcessed(state.iterations() * population.size());
+}
+
+void Arguments(benchmark::internal::Benchmark *b) {
+  b->Args({100, 10})->Args({1000, 10})->Args({1000, 100});
+}
+
+void BM_EvaluatorImpl(benchmark::State &state) {
+  RunEvaluator(state, EvaluatorImpl());
+}
+BENCHMARK(BM_EvaluatorImpl)->Apply(Arguments);
+
+void BM_BatchEvaluatorBaseline(benchmark::State &state) {
+  RunEvaluator(state, BatchEvaluator(BatchEvaluator::Isa::kBaseline));
+}
+BENCHMARK(BM_BatchEvaluatorBaseline)->Apply(Arguments);
+
+void BM_BatchEvaluator(benchmark::State &state) {
+  RunEvaluator(state, BatchEvaluator());
+}
+BENCHMARK(BM_BatchEvaluator)->Apply(Arguments);
+
+}  // namespace
+}  // namespace genetic
+}  // namespace lss
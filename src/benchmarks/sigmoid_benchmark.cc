@@ -0,0 +1,48 @@
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "base/sigmoid.h"
+
+namespace lss {
+namespace {
+
+// Normalized times as passed to the sigmoid by the objective function.
+std::vector<double> Arguments(size_t n) {
+  std::default_random_engine random(0);
+  std::normal_distribution<double> dist(0, 10);
+  std::vector<double> x(n);
+  for (double &v : x) v = dist(random);
+  return x;
+}
+
+template<double (*F)(double)>
+void BM_Sigmoid(benchmark::State &state) {
+  auto x = Arguments(state.range(0));
+  std::vector<double> out(x.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < x.size(); ++i)
+      out[i] = F(x[i]);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+BENCHMARK_TEMPLATE(BM_Sigmoid, ExactSigmoid)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_Sigmoid, FastSigmoid)->Arg(1 << 12);
+
+void BM_SigmoidArray(benchmark::State &state) {
+  auto x = Arguments(state.range(0));
+  std::vector<double> out(x.size());
+  for (auto _ : state) {
+    Sigmoid(x.data(), out.data(), x.size());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+BENCHMARK(BM_SigmoidArray)->Arg(1 << 12);
+
+}  // namespace
+}  // namespace lss
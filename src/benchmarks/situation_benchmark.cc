@@ -0,0 +1,114 @@
+#include <unistd.h>
+
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "base/raw_situation.h"
+#include "base/schedule.h"
+#include "base/situation.h"
+#include "benchmarks/allocation_counter.h"
+#include "benchmarks/situation_generator.h"
+#include "io/basic_input.h"
+#include "local_search/state.h"
+
+namespace lss {
+namespace benchmarks {
+namespace {
+
+RawSituation GetRawSituation(const benchmark::State &state) {
+  return GenerateRawSituation(GeneratorParams::ForJobs(state.range(0)));
+}
+
+// Assigns every job to a random machine from its machine set.
+Schedule GetRandomSchedule(Situation situation) {
+  std::default_random_engine random(0);
+  Schedule schedule(situation);
+  for (Job j : situation.jobs()) {
+    auto machines = j.machine_set().alive_machines();
+    if (machines.empty()) continue;
+    schedule.AssignJob(machines[random() % machines.size()], j);
+  }
+  return schedule;
+}
+
+void JobCounts(benchmark::internal::Benchmark *b) {
+  b->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+void BM_SituationConstruction(benchmark::State &state) {
+  RawSituation raw = GetRawSituation(state);
+  AllocationCounter allocations(&state);
+  for (auto _ : state) {
+    allocations.Start();
+    Situation situation(raw);
+    allocations.Stop();
+    benchmark::DoNotOptimize(situation.jobs().data());
+  }
+  state.SetItemsProcessed(state.iterations() * raw.jobs_.size());
+}
+BENCHMARK(BM_SituationConstruction)->Apply(JobCounts);
+
+void BM_BasicReaderRead(benchmark::State &state) {
+  RawSituation raw = GetRawSituation(state);
+  std::string path = "/tmp/lss_benchmark_input." + std::to_string(getpid());
+  io::BasicReader reader(path);
+  AllocationCounter allocations(&state);
+  for (auto _ : state) {
+    // The reader removes the file, so it has to be written again every time.
+    state.PauseTiming();
+    {
+      std::ofstream output(path);
+      WriteInput(raw, &output);
+    }
+    RawSituation destination;
+    state.ResumeTiming();
+
+    allocations.Start();
+    if (!reader.Read(&destination))
+      state.SkipWithError("Failed to read the input file");
+    allocations.Stop();
+  }
+  state.SetItemsProcessed(state.iterations() * raw.jobs_.size());
+}
+BENCHMARK(BM_BasicReaderRead)->Apply(JobCounts);
+
+void BM_ObjectiveFunction(benchmark::State &state) {
+  Situation situation(GetRawSituation(state));
+  Schedule schedule = GetRandomSchedule(situation);
+  AllocationCounter allocations(&state);
+  for (auto _ : state) {
+    allocations.Start();
+    benchmark::DoNotOptimize(ObjectiveFunction(schedule, situation));
+    allocations.Stop();
+  }
+  state.SetItemsProcessed(state.iterations() * situation.jobs().size());
+}
+BENCHMARK(BM_ObjectiveFunction)->Apply(JobCounts);
+
+void BM_StateAssign(benchmark::State &state) {
+  Situation situation(GetRawSituation(state));
+  Schedule schedule = GetRandomSchedule(situation);
+  AllocationCounter allocations(&state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    local_search::State s(situation);
+    state.ResumeTiming();
+
+    allocations.Start();
+    for (size_t queue = 0; queue < schedule.queue_count(); ++queue) {
+      for (Job j : schedule.jobs(queue))
+        s.Assign(schedule.machine(queue), j);
+    }
+    allocations.Stop();
+    benchmark::DoNotOptimize(s.Evaluate());
+  }
+  state.SetItemsProcessed(state.iterations() * situation.jobs().size());
+}
+BENCHMARK(BM_StateAssign)->Apply(JobCounts);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace lss
@@ -0,0 +1,153 @@
+#include "benchmarks/situation_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace lss {
+namespace benchmarks {
+namespace {
+
+constexpr int kContextBound = 5;
+constexpr Cost kMaxChangeCost = 1000;
+constexpr FloatType kMaxReward = 100;
+
+class Generator {
+ public:
+  explicit Generator(unsigned seed) : random_(seed) {}
+
+  // A uniformly distributed value rounded to two decimal places, like `randf` in objects.py.
+  FloatType Real(FloatType from, FloatType to) {
+    return std::round(std::uniform_real_distribution<FloatType>(from, to)(random_) * 100) / 100;
+  }
+
+  IdType Index(size_t count) {
+    return std::uniform_int_distribution<IdType>(0, count - 1)(random_);
+  }
+
+ private:
+  std::default_random_engine random_;
+};
+
+template<class Set>
+std::vector<Set> GenerateMachineSets(size_t count, size_t machines, Generator *generator) {
+  std::vector<Set> sets(count);
+  for (size_t id = 0; id < count; ++id)
+    sets[id].id(id);
+  for (size_t m = 0; m < machines; ++m)
+    sets[generator->Index(count)].add(m);
+  return sets;
+}
+
+}  // namespace
+
+GeneratorParams GeneratorParams::ForJobs(size_t jobs) {
+  GeneratorParams params;
+  params.jobs = jobs;
+  params.machines = std::max<size_t>(jobs / 10, 1);
+  params.machine_sets = std::max<size_t>(jobs / 1000, 1);
+  params.fair_sets = std::max<size_t>(jobs / 2000, 1);
+  params.batches = std::max<size_t>(jobs / 10, 1);
+  params.accounts = std::max<size_t>(jobs / 100, 1);
+  params.max_time = params.min_time + jobs;
+  return params;
+}
+
+RawSituation GenerateRawSituation(const GeneratorParams &params) {
+  Generator generator(params.seed);
+  RawSituation raw;
+  raw.time_stamp(params.min_time);
+
+  for (size_t id = 0; id < params.machines; ++id)
+    raw.add(RawMachine().id(id).state(MachineState::kIdle));
+  raw.machine_sets_ =
+      GenerateMachineSets<RawMachineSet>(params.machine_sets, params.machines, &generator);
+  raw.fair_sets_ = GenerateMachineSets<RawFairSet>(params.fair_sets, params.machines, &generator);
+
+  for (size_t id = 0; id < params.jobs; ++id) {
+    Time ready = generator.Real(params.min_time, params.max_time);
+    Context context;
+    for (int i = 0; i < Context::kSize; ++i)
+      context[i] = generator.Index(kContextBound);
+    raw.add(RawJob()
+        .id(id)
+        .batch(generator.Index(params.batches))
+        .duration(generator.Real(0, params.max_time - ready))
+        .machine_set(generator.Index(params.machine_sets))
+        .context(context));
+  }
+
+  for (size_t id = 0; id < params.batches; ++id) {
+    raw.add(RawBatch()
+        .id(id)
+        .account(generator.Index(params.accounts))
+        .job_reward(generator.Real(0, kMaxReward))
+        .job_timely_reward(generator.Real(0, kMaxReward))
+        .reward(generator.Real(0, kMaxReward))
+        .timely_reward(generator.Real(0, kMaxReward))
+        .duration(generator.Real(1, kMaxReward))
+        .due(generator.Real(params.min_time, params.max_time)));
+  }
+
+  for (size_t id = 0; id < params.accounts; ++id)
+    raw.add(RawAccount().id(id).alloc(generator.Real(0, 1)));
+
+  for (int i = 0; i < Change::kNum; ++i) {
+    raw.add(RawChangeCost()
+        .change(Change(i & 1, i & 2, i & 4))
+        .cost(generator.Index(kMaxChangeCost)));
+  }
+  return raw;
+}
+
+void WriteInput(const RawSituation &raw, std::ostream *output) {
+  output->precision(std::numeric_limits<double>::max_digits10);
+
+  *output << "machines\n";
+  for (const RawMachine &m : raw.machines_)
+    *output << m.id_ << ' ' << static_cast<int>(m.state_) << '\n';
+
+  *output << "machine-sets\n";
+  for (const RawMachineSet &set : raw.machine_sets_) {
+    *output << set.id_;
+    for (IdType m : set.machines_) *output << ' ' << m;
+    *output << '\n';
+  }
+
+  *output << "fair-service-machine-sets\n";
+  for (const RawFairSet &set : raw.fair_sets_) {
+    *output << set.id_;
+    for (IdType m : set.machines_) *output << ' ' << m;
+    *output << '\n';
+  }
+
+  *output << "jobs\n";
+  for (const RawJob &j : raw.jobs_) {
+    *output << j.id_ << ' ' << j.batch_ << ' ' << j.duration_ << ' ' << j.machine_set_;
+    for (int i = 0; i < Context::kSize; ++i) *output << ' ' << j.context_[i];
+    *output << '\n';
+  }
+
+  *output << "batches\n";
+  for (const RawBatch &b : raw.batches_) {
+    *output << b.id_ << ' ' << b.account_ << ' '
+        << b.job_reward_ << ' ' << b.job_timely_reward_ << ' '
+        << b.reward_ << ' ' << b.timely_reward_ << ' '
+        << b.duration_ << ' ' << b.due_ << '\n';
+  }
+
+  *output << "accounts\n";
+  for (const RawAccount &a : raw.accounts_)
+    *output << a.id_ << ' ' << a.alloc_ << '\n';
+
+  *output << "context-changes\n";
+  for (const RawChangeCost &c : raw.change_costs_) {
+    for (int i = 0; i < Change::kSize; ++i) *output << c.change_[i] << ' ';
+    *output << c.cost_ << '\n';
+  }
+}
+
+}  // namespace benchmarks
+}  // namespace lss
@@ -0,0 +1,40 @@
+#ifndef LSS_BENCHMARKS_SITUATION_GENERATOR_H_
+#define LSS_BENCHMARKS_SITUATION_GENERATOR_H_
+
+#include <cstddef>
+#include <ostream>
+
+#include "base/raw_situation.h"
+#include "base/types.h"
+
+namespace lss {
+namespace benchmarks {
+
+// Parameters of generated situations, following StoryGenerator in system_tests/generators.
+struct GeneratorParams {
+  Time min_time = 0;
+  Time max_time = 1000;
+  size_t machines = 10;
+  size_t machine_sets = 3;
+  size_t fair_sets = 2;
+  size_t jobs = 100;
+  size_t batches = 10;
+  size_t accounts = 5;
+  unsigned seed = 0;
+
+  // Parameters for `jobs` jobs, with the other counts scaled proportionally.
+  static GeneratorParams ForJobs(size_t jobs);
+};
+
+// Generates a random situation at `params.min_time`. Like StoryGenerator,
+// every machine belongs to one random machine set and one random fair set, and
+// every job to one random batch (and every batch to one random account).
+RawSituation GenerateRawSituation(const GeneratorParams &params);
+
+// Writes `raw` in the format read by io::BasicReader.
+void WriteInput(const RawSituation &raw, std::ostream *output);
+
+}  // namespace benchmarks
+}  // namespace lss
+
+#endif  // LSS_BENCHMARKS_SITUATION_GENERATOR_H_
@@ -1,85 +1,66 @@
 #ifndef LSS_GENETIC_ALGORITHM_H_
 #define LSS_GENETIC_ALGORITHM_H_
 
-#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <utility>
 #include <vector>
 
-#include "base/algorithm.h"
 #include "base/random.h"
 #include "base/schedule.h"
 #include "base/situation.h"
 #include "genetic/moves.h"
+#include "genetic/static_algorithm.h"
 
 namespace lss {
 namespace genetic {
 
+// Adapts virtual `Moves` to the moves of StaticGeneticAlgorithm, which holds them by value.
 template<class T>
-class GeneticAlgorithm : public Algorithm {
+class MovesRef {
  public:
-  GeneticAlgorithm(int population_size,
-                   int number_of_generations,
-                   double crossover_probability,
-                   std::shared_ptr<Moves<T>> moves,
-                   std::shared_ptr<Random> rand)
-      : population_size_(population_size),
-        number_of_generations_(number_of_generations),
-        crossover_probability_(crossover_probability),
-        moves_(moves),
-        rand_(rand) { }
+  explicit MovesRef(std::shared_ptr<Moves<T>> moves) : moves_(std::move(moves)) {}
 
-  Schedule Run(const Schedule &prev_schedule, Situation new_situation) override;
+  Population<T> InitPopulation(Situation situation, int population_size) {
+    return moves_->InitPopulation(situation, population_size);
+  }
+  Population<T> Select(Situation situation, const Population<T> &population,
+                       ChromosomeImprover<T> *improver) {
+    return moves_->Select(situation, population, improver);
+  }
+  void Crossover(T *lhs, T *rhs) { moves_->Crossover(lhs, rhs); }
+  void Mutate(Situation situation, T *chromosome) { moves_->Mutate(situation, chromosome); }
 
  private:
-  void Crossover(Population<T> *population);
-  void Mutate(Situation situation, Population<T> *population);
-
-  int population_size_;
-  int number_of_generations_;
-  double crossover_probability_;
   std::shared_ptr<Moves<T>> moves_;
-  std::shared_ptr<Random> rand_;
 };
 
-template<class T>
-Schedule GeneticAlgorithm<T>::Run(__attribute__((unused)) const Schedule &prev_schedule,
-                                  Situation new_situation) {
-  ChromosomeImprover<T> improver;
-  Population<T> population = moves_->InitPopulation(new_situation, population_size_);
-  for (int generation = 0; generation < number_of_generations_; ++generation) {
-    population = moves_->Select(new_situation, population, &improver);
-    Crossover(&population);
-    Mutate(new_situation, &population);
-  }
-  return improver.GetBestChromosome().ToSchedule(new_situation);
-}
+// Adapts a shared (possibly mocked) `Random` to the `Rng` of StaticGeneticAlgorithm.
+class RandomRef {
+ public:
+  explicit RandomRef(std::shared_ptr<Random> rand) : rand_(std::move(rand)) {}
 
-template<class T>
-void GeneticAlgorithm<T>::Crossover(Population<T> *population) {
-  std::vector<size_t> indexes(population->size());
-  std::iota(std::begin(indexes), std::end(indexes), 0);
-  rand_->RandomShuffle(&indexes);
-  T *chromosome_waiting_for_crossover = nullptr;
-  for (size_t i = 0; i < population->size(); ++i) {
-    bool take_to_crossover = rand_->GetRealInRange(0., 1.) < crossover_probability_;
-    if (take_to_crossover) {
-      if (chromosome_waiting_for_crossover) {
-        moves_->Crossover(chromosome_waiting_for_crossover, &(*population)[indexes[i]]);
-        chromosome_waiting_for_crossover = nullptr;
-      } else {
-        chromosome_waiting_for_crossover = &(*population)[indexes[i]];
-      }
-    }
-  }
-}
+  double GetRealInRange(double from, double to) { return rand_->GetRealInRange(from, to); }
+  void RandomShuffle(std::vector<size_t> *v) { rand_->RandomShuffle(v); }
 
+ private:
+  std::shared_ptr<Random> rand_;
+};
+
+// StaticGeneticAlgorithm composed of mockable virtual moves and random number generator.
 template<class T>
-void GeneticAlgorithm<T>::Mutate(Situation situation, Population<T> *population) {
-  for (T &chromosome : *population) {
-    moves_->Mutate(situation, &chromosome);
-  }
-}
+class GeneticAlgorithm : public StaticGeneticAlgorithm<T, MovesRef<T>, MovesRef<T>, MovesRef<T>,
+                                                       MovesRef<T>, RandomRef> {
+ public:
+  GeneticAlgorithm(int population_size,
+                   int number_of_generations,
+                   double crossover_probability,
+                   std::shared_ptr<Moves<T>> moves,
+                   std::shared_ptr<Random> rand)
+      : StaticGeneticAlgorithm<T, MovesRef<T>, MovesRef<T>, MovesRef<T>, MovesRef<T>, RandomRef>(
+            population_size, number_of_generations, crossover_probability, MovesRef<T>(moves),
+            MovesRef<T>(moves), MovesRef<T>(moves), MovesRef<T>(moves), RandomRef(rand)) {}
+};
 
 class Chromosome {
  public:
@@ -16,6 +16,7 @@ namespace genetic {
 using ::testing::_;
 using ::testing::Return;
 using ::testing::SetArgPointee;
+using ::testing::Invoke;
 using ::testing::InvokeWithoutArgs;
 
 class CrosserFake : public Crosser<ChromosomeFake> {
@@ -119,6 +120,33 @@ TEST_F(AlgorithmShould, call_InitPopulation_once_and_RandomShuffle_and_Select_in
   algorithm.Run(schedule_, situation_);
 }
 
+TEST_F(AlgorithmShould, flush_one_trace_point_per_generation) {
+  number_of_generations_ = 3;
+  EXPECT_CALL(*moves_, InitPopulation(_, population_size_))
+      .WillOnce(Return(Population<Chromosome>()));
+  EXPECT_CALL(*moves_, Select(_, _, _))
+      .Times(number_of_generations_)
+      .WillRepeatedly(Return(Population<Chromosome>()));
+  EXPECT_CALL(*rand_, RandomShuffle(_)).Times(number_of_generations_);
+
+  std::vector<TracePoint> points;
+  auto sink = std::make_shared<TraceSinkMock>();
+  EXPECT_CALL(*sink, Flush("genetic", 0, _))
+      .WillOnce(Invoke([&points](const std::string &, int64_t, const Trace &trace) {
+        points = trace.Points();
+      }));
+
+  GeneticAlgorithm<Chromosome> algorithm = BuildAlgorithm();
+  algorithm.SetTraceSink(sink);
+  algorithm.Run(schedule_, situation_);
+
+  ASSERT_EQ(number_of_generations_, points.size());
+  for (int generation = 0; generation < number_of_generations_; ++generation) {
+    EXPECT_EQ(generation, points[generation].step);
+    EXPECT_GE(points[generation].nanos, 0);
+  }
+}
+
 TEST_F(AlgorithmShould, take_chromosomes_to_crossover_according_to_generated_random_number) {
   EXPECT_CALL(*rand_, RandomShuffle(_));
   auto crosser = std::make_shared<CrosserFake>();
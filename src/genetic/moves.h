@@ -28,6 +28,16 @@ class Evaluator {
  public:
   virtual double Evaluate(Situation situation, const T &chromosome) const = 0;
 
+  // Returns evaluations of all chromosomes in `population` (in the same order).
+  // Implementations may override it to evaluate many chromosomes at once.
+  virtual std::vector<double> EvaluateAll(Situation situation,
+                                          const Population<T> &population) const {
+    std::vector<double> fitnesses;
+    for (const T &chromosome : population)
+      fitnesses.push_back(Evaluate(situation, chromosome));
+    return fitnesses;
+  }
+
   virtual ~Evaluator() = default;
 };
 
@@ -41,9 +51,16 @@ class ChromosomeImprover {
   virtual void TryImprove(const T &chromosome, double fitness);
   virtual void TryImprove(const ChromosomeImprover<T> &other);
 
+  // Keeps the mean and the standard deviation of `fitnesses` of the last selected population.
+  void RecordPopulation(const std::vector<double> &fitnesses);
+  double GetMeanFitness() const { return mean_fitness_; }
+  double GetFitnessDeviation() const { return fitness_deviation_; }
+
  private:
   std::shared_ptr<T> best_chromosome_ = std::make_shared<T>();
-  double best_fitness_ = std::numeric_limits<double>::min();
+  double best_fitness_ = std::numeric_limits<double>::lowest();
+  double mean_fitness_ = 0.;
+  double fitness_deviation_ = 0.;
 };
 
 template<class T>
@@ -0,0 +1,276 @@
+#include "genetic/permutation_chromosome/batch_evaluator.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+
+#include "base/imbalance.h"
+#include "base/sigmoid.h"
+
+namespace lss {
+namespace genetic {
+namespace {
+
+constexpr size_t kLanes = BatchEvaluator::kLanes;
+constexpr int kNone = -1;
+constexpr Time kNotFinished = std::numeric_limits<Time>::lowest();
+
+}  // namespace
+
+// Dense indices are positions in `Situation::jobs()`, `Situation::machines()`
+// and `Situation::batches()`.
+struct BatchEvaluator::DenseSituation {
+  explicit DenseSituation(Situation situation);
+
+  // Copies of a situation share their data, the change costs included.
+  bool Of(Situation other) const { return &other.change_costs() == &change_costs; }
+
+  int JobIndex(Job job) const { return job_index.at(job); }
+  Job GetJob(int index) const { return situation.jobs()[index]; }
+  Machine GetMachine(int index) const {
+    return index < machines ? situation.machines()[index] : Machine();
+  }
+
+  // Jobs assigned to a machine which is not in the situation (e.g. null `Machine`)
+  // share the last machine index, just like they would share a queue in `Schedule`.
+  int MachineIndex(Machine machine) const {
+    auto it = machine_index.find(machine);
+    return it == machine_index.end() ? machines : it->second;
+  }
+
+  // See ChangeCosts::setup_cost().
+  Cost SetupCost(Context from, int to_job) const {
+    return change_costs.setup_cost(from, context[to_job]);
+  }
+
+  Situation situation;  // Keeps `change_costs` alive.
+  const ChangeCosts &change_costs;
+  Time time_stamp;
+  int machines;
+  std::unordered_map<Job, int> job_index;
+  std::unordered_map<Machine, int> machine_index;
+
+  // Per machine; the last element is for jobs on machines outside the situation.
+  std::vector<Time> free_time;
+  std::vector<Context> last_context;
+
+  // Per job.
+  std::vector<Duration> duration;
+  std::vector<Context> context;
+  std::vector<int> batch;
+
+  // Per batch.
+  std::vector<double> reward, timely_reward, job_reward, job_timely_reward;
+  std::vector<Time> due;
+  std::vector<Duration> batch_duration;
+};
+
+BatchEvaluator::DenseSituation::DenseSituation(Situation situation)
+    : situation(situation),
+      change_costs(situation.change_costs()),
+      time_stamp(situation.time_stamp()),
+      machines(situation.machines().size()) {
+  for (size_t i = 0; i < situation.machines().size(); ++i) {
+    machine_index[situation.machines()[i]] = i;
+    free_time.push_back(situation.machines()[i].free_time());
+    last_context.push_back(situation.machines()[i].last_context());
+  }
+  free_time.push_back(time_stamp);
+  last_context.push_back(Context());
+
+  std::unordered_map<Batch, int> batch_index;
+  for (Batch b : situation.batches()) {
+    batch_index[b] = reward.size();
+    reward.push_back(b.reward());
+    timely_reward.push_back(b.timely_reward());
+    job_reward.push_back(b.job_reward());
+    job_timely_reward.push_back(b.job_timely_reward());
+    due.push_back(b.due());
+    batch_duration.push_back(b.duration());
+  }
+
+  for (Job j : situation.jobs()) {
+    job_index[j] = duration.size();
+    duration.push_back(j.duration());
+    context.push_back(j.context());
+    auto it = batch_index.find(j.batch());
+    batch.push_back(it == batch_index.end() ? kNone : it->second);
+  }
+}
+
+namespace {
+
+using DenseSituation = BatchEvaluator::DenseSituation;
+
+// Genes of up to `kLanes` chromosomes; gene `i` of the chromosome in lane `l`
+// is at index `i * kLanes + l`. Lanes of shorter chromosomes are padded with `kNone`.
+struct Group {
+  size_t length;
+  std::vector<int> job, machine;
+};
+
+// Buffers reused between groups to avoid reallocation.
+struct Buffers {
+  std::vector<Time> clock;  // Indexed by `machine * kLanes + lane`.
+  std::vector<Context> context;  // Indexed like `clock`.
+  std::vector<Time> batch_finish;  // Indexed by `batch * kLanes + lane`.
+  std::vector<Time> finish;  // Finish times of jobs, indexed like genes.
+  // Arguments of reward terms `base + scale * FastSigmoid(x)`, indexed like genes.
+  std::vector<double> x, base, scale;
+};
+
+// Adds `base[k] + scale[k] * FastSigmoid(x[k])` to `sum[k % kLanes]` for `k < rows * kLanes`.
+// Written so that the fixed size inner loop can be vectorized; std::exp() would not be.
+__attribute__((always_inline))
+inline void AccumulateRewards(const Buffers &buffers, size_t rows, double *sum) {
+  const double *x = buffers.x.data(), *base = buffers.base.data(), *scale = buffers.scale.data();
+  for (size_t row = 0; row < rows; ++row) {
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      size_t k = row * kLanes + lane;
+      sum[lane] += base[k] + scale[k] * FastSigmoid(x[k]);
+    }
+  }
+}
+
+__attribute__((always_inline))
+inline void EvaluateGroupKernel(const DenseSituation &s, const Group &group, Buffers *b,
+                                double *sum) {
+  size_t batches = s.reward.size();
+  b->clock.resize((s.machines + 1) * kLanes);
+  b->context.resize(b->clock.size());
+  for (size_t k = 0; k < b->clock.size(); ++k) {
+    b->clock[k] = s.free_time[k / kLanes];
+    b->context[k] = s.last_context[k / kLanes];
+  }
+  b->batch_finish.assign(batches * kLanes, kNotFinished);
+  size_t genes = std::max(group.length, batches) * kLanes;
+  b->x.assign(genes, 0);
+  b->base.assign(genes, 0);
+  b->scale.assign(genes, 0);
+  b->finish.resize(group.length * kLanes);
+
+  // Machine clocks have to be simulated gene by gene, as lanes address different
+  // machines (there is no scatter in AVX2).
+  for (size_t k = 0; k < group.length * kLanes; ++k) {
+    int job = group.job[k];
+    if (job == kNone) continue;
+    size_t slot = group.machine[k] * kLanes + k % kLanes;
+    Time time = b->clock[slot] + (s.duration[job] + s.SetupCost(b->context[slot], job));
+    b->clock[slot] = time;
+    b->context[slot] = s.context[job];
+    b->finish[k] = time;
+
+    int batch = s.batch[job];
+    if (batch == kNone) continue;
+    Time &finish = b->batch_finish[batch * kLanes + k % kLanes];
+    finish = std::max(finish, time);
+    b->x[k] = (time - s.due[batch]) / s.batch_duration[batch];
+    b->base[k] = s.job_reward[batch];
+    b->scale[k] = s.job_timely_reward[batch];
+  }
+  AccumulateRewards(*b, group.length, sum);
+
+  for (size_t batch = 0; batch < batches; ++batch) {
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      size_t k = batch * kLanes + lane;
+      bool finished = b->batch_finish[k] != kNotFinished;
+      b->x[k] = finished ? (b->batch_finish[k] - s.due[batch]) / s.batch_duration[batch] : 0;
+      b->base[k] = finished ? s.reward[batch] : 0;
+      b->scale[k] = finished ? s.timely_reward[batch] : 0;
+    }
+  }
+  AccumulateRewards(*b, batches, sum);
+}
+
+void EvaluateGroupBaseline(const DenseSituation &s, const Group &group, Buffers *b,
+                           double *sum) {
+  EvaluateGroupKernel(s, group, b, sum);
+}
+
+__attribute__((target("avx2")))
+void EvaluateGroupAvx2(const DenseSituation &s, const Group &group, Buffers *b, double *sum) {
+  EvaluateGroupKernel(s, group, b, sum);
+}
+
+}  // namespace
+
+constexpr size_t BatchEvaluator::kLanes;
+
+BatchEvaluator::BatchEvaluator(Isa isa, double imbalance_factor)
+    : imbalance_factor_(imbalance_factor) {
+  if (isa == Isa::kAvx2 && !CpuSupportsAvx2())
+    throw std::invalid_argument("AVX2 is not supported by the CPU.");
+  use_avx2_ = isa == Isa::kAvx2 || (isa == Isa::kAuto && CpuSupportsAvx2());
+}
+
+bool BatchEvaluator::CpuSupportsAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+double BatchEvaluator::Evaluate(Situation situation,
+                                const PermutationJobMachine &chromosome) const {
+  return EvaluateAll(situation, {chromosome}).front();
+}
+
+std::shared_ptr<const BatchEvaluator::DenseSituation> BatchEvaluator::GetDenseSituation(
+    Situation situation) const {
+  std::lock_guard<std::mutex> lock(cache_->mutex);
+  if (!cache_->dense || !cache_->dense->Of(situation))
+    cache_->dense = std::make_shared<const DenseSituation>(situation);
+  return cache_->dense;
+}
+
+std::vector<double> BatchEvaluator::EvaluateAll(
+    Situation situation, const Population<PermutationJobMachine> &population) const {
+  std::shared_ptr<const DenseSituation> dense_ptr = GetDenseSituation(situation);
+  const DenseSituation &dense = *dense_ptr;
+  std::vector<double> fitnesses(population.size());
+  Group group;
+  Buffers buffers;
+  ImbalanceEvaluator imbalance(situation);
+
+  for (size_t first = 0; first < population.size(); first += kLanes) {
+    size_t lanes = std::min(kLanes, population.size() - first);
+    group.length = 0;
+    for (size_t lane = 0; lane < lanes; ++lane)
+      group.length = std::max(group.length, population[first + lane].permutation().size());
+
+    group.job.assign(group.length * kLanes, kNone);
+    group.machine.assign(group.length * kLanes, 0);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      const auto &permutation = population[first + lane].permutation();
+      for (size_t i = 0; i < permutation.size(); ++i) {
+        group.job[i * kLanes + lane] = dense.JobIndex(std::get<0>(permutation[i]));
+        group.machine[i * kLanes + lane] = dense.MachineIndex(std::get<1>(permutation[i]));
+      }
+    }
+
+    double sum[kLanes] = {};
+    if (use_avx2_)
+      EvaluateGroupAvx2(dense, group, &buffers, sum);
+    else
+      EvaluateGroupBaseline(dense, group, &buffers, sum);
+
+    for (size_t lane = 0; imbalance_factor_ != 0. && lane < lanes; ++lane) {
+      imbalance.Clear();
+      for (size_t k = lane; k < group.length * kLanes; k += kLanes) {
+        int job = group.job[k];
+        if (job == kNone || dense.batch[job] == kNone) continue;
+        Time finish = buffers.finish[k];
+        imbalance.AddJob(dense.GetMachine(group.machine[k]), dense.GetJob(job),
+                         finish - dense.duration[job], finish);
+      }
+      sum[lane] -= imbalance_factor_ * imbalance.Compute();
+    }
+    std::copy(sum, sum + lanes, fitnesses.begin() + first);
+  }
+  return fitnesses;
+}
+
+}  // namespace genetic
+}  // namespace lss
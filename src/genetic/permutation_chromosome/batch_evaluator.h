@@ -0,0 +1,62 @@
+#ifndef LSS_GENETIC_PERMUTATION_CHROMOSOME_BATCH_EVALUATOR_H_
+#define LSS_GENETIC_PERMUTATION_CHROMOSOME_BATCH_EVALUATOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "base/situation.h"
+#include "genetic/moves.h"
+#include "genetic/permutation_chromosome/chromosome.h"
+
+namespace lss {
+namespace genetic {
+
+// Computes the same value as `EvaluatorImpl` (up to rounding) without building
+// a `Schedule`. Chromosomes are transposed into `kLanes` lanes, so that the machine clocks
+// and rewards of `kLanes` chromosomes are computed by the same instructions.
+// The kernel is compiled both for AVX2 and for the baseline instruction set;
+// the variant is chosen at runtime based on the CPU. Rewards are computed with FastSigmoid(),
+// whichever Sigmoid() is selected by LSS_FAST_SIGMOID, so that they are vectorized too.
+class BatchEvaluator : public Evaluator<PermutationJobMachine> {
+ public:
+  static constexpr size_t kLanes = 8;
+
+  enum class Isa {
+    kAuto,      // AVX2 if supported by the CPU, kBaseline otherwise.
+    kBaseline,
+    kAvx2,      // Must be supported by the CPU.
+  };
+
+  // `imbalance_factor` is passed to ObjectiveFunction(); the imbalance is not vectorized.
+  explicit BatchEvaluator(Isa isa = Isa::kAuto, double imbalance_factor = 0.);
+
+  double Evaluate(Situation situation, const PermutationJobMachine &chromosome) const override;
+  std::vector<double> EvaluateAll(
+      Situation situation, const Population<PermutationJobMachine> &population) const override;
+
+  static bool CpuSupportsAvx2();
+
+  // Situation data addressed by dense indices, defined in the .cc file.
+  struct DenseSituation;
+
+ private:
+  // The last `DenseSituation` built, shared by copies of the evaluator.
+  struct Cache {
+    std::mutex mutex;
+    std::shared_ptr<const DenseSituation> dense;
+  };
+
+  // Built once per situation, as populations of a run are all evaluated in the same one.
+  std::shared_ptr<const DenseSituation> GetDenseSituation(Situation situation) const;
+
+  bool use_avx2_;
+  double imbalance_factor_;
+  std::shared_ptr<Cache> cache_ = std::make_shared<Cache>();
+};
+
+}  // namespace genetic
+}  // namespace lss
+
+#endif  // LSS_GENETIC_PERMUTATION_CHROMOSOME_BATCH_EVALUATOR_H_
@@ -0,0 +1,109 @@
+#include "genetic/permutation_chromosome/batch_evaluator.h"
+
+#include <memory>
+#include <tuple>
+
+#include "gtest/gtest.h"
+
+#include "base/raw_situation.h"
+#include "genetic/permutation_chromosome/moves_impl.h"
+
+namespace lss {
+namespace genetic {
+namespace {
+
+const int kJobs = 40;
+const int kMachines = 3;
+const int kBatches = 4;
+
+// Jobs of several batches with different contexts, so that change costs matter.
+RawSituation GetRawSituation() {
+  RawSituation raw;
+  raw.time_stamp(5).add(RawAccount().id(0).alloc(0.5)).add(RawFairSet().id(0).add(0).add(1));
+  RawMachineSet machine_set;
+  machine_set.id(0);
+  for (int id = 0; id < kMachines; ++id) {
+    raw.add(RawMachine().id(id));
+    machine_set.add(id);
+  }
+  raw.add(machine_set);
+  for (int i = 0; i < 8; ++i)
+    raw.add(RawChangeCost().change(Change(i & 1, i & 2, i & 4)).cost(i));
+  for (int id = 0; id < kBatches; ++id) {
+    raw.add(RawBatch().id(id).account(0).reward(id + 1).timely_reward(10 * id + 3)
+                .job_reward(0.5).job_timely_reward(id + 0.25).duration(7 + id).due(20 + 15 * id));
+  }
+  for (int id = 0; id < kJobs; ++id) {
+    raw.add(RawJob().id(id).batch(id % kBatches).machine_set(0).duration(1 + id % 5)
+                .context(Context{id % 2, id % 3, id % 4}));
+  }
+  return raw;
+}
+
+class BatchEvaluatorTest : public ::testing::Test {
+ protected:
+  BatchEvaluatorTest() : situation_(GetRawSituation()) {}
+
+  void CheckMatchesEvaluatorImpl(BatchEvaluator::Isa isa, double imbalance_factor = 0.) {
+    BatchEvaluator evaluator(isa, imbalance_factor);
+    InitializerImpl initializer(std::make_shared<Random>());
+    for (int size : {1, 8, 13}) {
+      auto population = initializer.InitPopulation(situation_, size);
+      // Chromosomes of different lengths are evaluated together.
+      population.back().permutation().resize(kJobs / 2);
+
+      auto fitnesses = evaluator.EvaluateAll(situation_, population);
+      ASSERT_EQ(size, fitnesses.size());
+      for (int i = 0; i < size; ++i) {
+        double expected = EvaluatorImpl(imbalance_factor).Evaluate(situation_, population[i]);
+        EXPECT_NEAR(expected, fitnesses[i], 1e-6);
+        EXPECT_NEAR(expected, evaluator.Evaluate(situation_, population[i]), 1e-6);
+      }
+    }
+  }
+
+  Situation situation_;
+};
+
+TEST_F(BatchEvaluatorTest, Baseline) {
+  CheckMatchesEvaluatorImpl(BatchEvaluator::Isa::kBaseline);
+}
+
+TEST_F(BatchEvaluatorTest, Avx2) {
+  if (!BatchEvaluator::CpuSupportsAvx2())
+    return;
+  CheckMatchesEvaluatorImpl(BatchEvaluator::Isa::kAvx2);
+}
+
+TEST_F(BatchEvaluatorTest, Imbalance) {
+  CheckMatchesEvaluatorImpl(BatchEvaluator::Isa::kBaseline, 0.25);
+}
+
+TEST_F(BatchEvaluatorTest, EmptyChromosome) {
+  BatchEvaluator evaluator;
+  EXPECT_EQ(0, evaluator.Evaluate(situation_, PermutationJobMachine()));
+  EXPECT_TRUE(evaluator.EvaluateAll(situation_, {}).empty());
+}
+
+// Verify that data of the previous situation is not reused for a new one.
+TEST_F(BatchEvaluatorTest, NewSituation) {
+  BatchEvaluator evaluator;
+  auto chromosome = InitializerImpl(std::make_shared<Random>()).InitPopulation(situation_, 1)[0];
+  evaluator.Evaluate(situation_, chromosome);
+
+  RawSituation raw = GetRawSituation();
+  for (RawJob &job : raw.jobs_)
+    job.duration(2 * job.duration_);
+  Situation situation(raw);
+  // Jobs and machines of the new situation with the same ids.
+  for (auto &gene : chromosome.permutation()) {
+    std::get<0>(gene) = situation[std::get<0>(gene).id()];
+    std::get<1>(gene) = situation[std::get<1>(gene).id()];
+  }
+  EXPECT_NEAR(EvaluatorImpl().Evaluate(situation, chromosome),
+              evaluator.Evaluate(situation, chromosome), 1e-6);
+}
+
+}  // namespace
+}  // namespace genetic
+}  // namespace lss
@@ -24,6 +24,10 @@ class PermutationJobMachine : public Chromosome {
     return permutation_;
   }
 
+  const std::vector<JobMachine> &permutation() const {
+    return permutation_;
+  }
+
   Schedule ToSchedule(Situation situation) const override {
     Schedule schedule(situation);
     for (JobMachine jobMachine : permutation_) {
@@ -1,15 +1,45 @@
 #include "genetic/permutation_chromosome/common.h"
 
+#include <unordered_set>
+
 #include "base/random.h"
 #include "genetic/permutation_chromosome/chromosome.h"
 
 namespace lss {
 namespace genetic {
+namespace {
+
+void Merge(std::vector<JobMachine> *to,
+           const std::vector<JobMachine> &from,
+           size_t min_bound,
+           size_t max_bound) {
+  std::unordered_set<Job> already_taken;
+  for (size_t i = min_bound; i < max_bound; ++i) {
+    already_taken.insert(std::get<0>((*to)[i]));
+  }
+
+  auto it = from.begin();
+  for (size_t i = 0; i < min_bound; ++i) {
+    // I assume vectors '*to' and 'from' have the same size
+    // and are permutations by jobs, thus I don't need to check
+    // that the iterator is valid.
+    while (already_taken.count(std::get<0>(*it)) > 0)
+      ++it;
+    (*to)[i] = *it;
+    ++it;
+  }
+  for (size_t i = max_bound; i < to->size(); ++i) {
+    while (already_taken.count(std::get<0>(*it)) > 0)
+      ++it;
+    (*to)[i] = *it;
+    ++it;
+  }
+}
+
+}  // namespace
 
 Machine FindRandomMachineForJob(Job job, Random *rand) {
-  MachineSet::Machines available_machines = job.machine_set().machines();
-  size_t index = rand->Rand(available_machines.size());
-  return available_machines[index];
+  return FindRandomMachineForJob<Random>(job, rand);
 }
 
 std::vector<JobMachine> GetPermutation(const std::vector<int> &job_permutation,
@@ -25,5 +55,30 @@ std::vector<JobMachine> GetPermutation(const std::vector<int> &job_permutation,
   return permutation;
 }
 
+PermutationJobMachine ChromosomeFromSchedule(const Schedule &schedule, Situation situation,
+                                             Random *rand) {
+  PermutationJobMachine chromosome;
+  std::unordered_set<Job> scheduled;
+  // Machines are visited in the order of ids to keep the result deterministic.
+  for (Machine m : situation.machines()) {
+    for (Job job : schedule.jobs(m)) {
+      chromosome.permutation().push_back(std::make_tuple(job, m));
+      scheduled.insert(job);
+    }
+  }
+  for (Job job : situation.jobs()) {
+    if (!scheduled.count(job))
+      chromosome.permutation().push_back(std::make_tuple(job, FindRandomMachineForJob(job, rand)));
+  }
+  return chromosome;
+}
+
+void OrderCrossover(std::vector<JobMachine> *lhs, std::vector<JobMachine> *rhs,
+                    size_t min_bound, size_t max_bound) {
+  std::vector<JobMachine> lhs_copy = *lhs;
+  Merge(lhs, *rhs, min_bound, max_bound);
+  Merge(rhs, lhs_copy, min_bound, max_bound);
+}
+
 }  // namespace genetic
 }  // namespace lss
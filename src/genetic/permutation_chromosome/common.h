@@ -1,9 +1,12 @@
 #ifndef LSS_GENETIC_PERMUTATION_CHROMOSOME_COMMON_H_
 #define LSS_GENETIC_PERMUTATION_CHROMOSOME_COMMON_H_
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "base/random.h"
+#include "base/schedule.h"
 #include "base/situation.h"
 #include "genetic/permutation_chromosome/chromosome.h"
 
@@ -12,10 +15,87 @@ namespace genetic {
 
 Machine FindRandomMachineForJob(Job job, Random *rand);
 
+// Version of FindRandomMachineForJob() for any generator with Rand(), e.g. FastRandom.
+template<class Rng>
+Machine FindRandomMachineForJob(Job job, Rng *rand) {
+  // Fall back to dead machines rather than leaving the job without a machine.
+  MachineSet::Machines available_machines = job.machine_set().alive_machines().empty()
+      ? job.machine_set().machines() : job.machine_set().alive_machines();
+  size_t index = rand->Rand(available_machines.size());
+  return available_machines[index];
+}
+
+// Changes of a single gene which keep the permutation valid.
+enum class Mutation {
+  kMachine,    // Moves the job to a random machine of its machine set.
+  kSwap,       // Swaps the gene with a random one.
+  kInversion,  // Reverses the genes between the gene and a random one.
+  kInsert,     // Moves the gene to a random position.
+};
+
+template<class Rng>
+void ApplyMutation(Mutation mutation, size_t position, std::vector<JobMachine> *permutation,
+                   Rng *rand) {
+  std::vector<JobMachine> &genes = *permutation;
+  if (mutation == Mutation::kMachine) {
+    Job job = std::get<0>(genes[position]);
+    genes[position] = std::make_tuple(job, FindRandomMachineForJob(job, rand));
+    return;
+  }
+  size_t other = rand->Rand(genes.size());
+  if (mutation == Mutation::kSwap) {
+    std::swap(genes[position], genes[other]);
+  } else if (mutation == Mutation::kInversion) {
+    std::reverse(genes.begin() + std::min(position, other),
+                 genes.begin() + std::max(position, other) + 1);
+  } else if (position < other) {
+    std::rotate(genes.begin() + position, genes.begin() + position + 1,
+                genes.begin() + other + 1);
+  } else {
+    std::rotate(genes.begin() + other, genes.begin() + position, genes.begin() + position + 1);
+  }
+}
+
+// Applies one of `mutations`, chosen uniformly, at every position of `permutation`
+// independently with `probability`. Instead of drawing a number per gene, gaps between
+// mutated positions are drawn from the geometric distribution, so the cost is proportional
+// to the number of mutations.
+template<class Rng>
+void MutatePermutation(double probability, const std::vector<Mutation> &mutations,
+                       std::vector<JobMachine> *permutation, Rng *rand) {
+  if (probability <= 0. || mutations.empty())
+    return;
+  double log_keep = std::log1p(-probability);
+  size_t size = permutation->size();
+  for (size_t position = 0;; ++position) {
+    if (probability < 1.) {
+      // P(skip >= k) = (1 - probability)^k; 1 - U is in (0, 1], so the logarithm is finite.
+      double skip = std::floor(std::log(1. - rand->GetRealInRange(0., 1.)) / log_keep);
+      if (skip >= size - position)
+        return;
+      position += static_cast<size_t>(skip);
+    } else if (position >= size) {
+      return;
+    }
+    size_t index = mutations.size() == 1 ? 0 : rand->Rand(mutations.size());
+    ApplyMutation(mutations[index], position, permutation, rand);
+  }
+}
+
+// Order crossover: genes of `lhs` and `rhs` in [min_bound, max_bound) stay in place and
+// the other ones are filled with the missing jobs in the order of the other parent.
+void OrderCrossover(std::vector<JobMachine> *lhs, std::vector<JobMachine> *rhs,
+                    size_t min_bound, size_t max_bound);
+
 std::vector<JobMachine> GetPermutation(const std::vector<int> &job_permutation,
                                        const std::vector<int> &machines,
                                        Situation situation);
 
+// Returns a chromosome with queues of `schedule` (so that ToSchedule() gives it back)
+// followed by jobs missing from it on random machines.
+PermutationJobMachine ChromosomeFromSchedule(const Schedule &schedule, Situation situation,
+                                             Random *rand);
+
 }  // namespace genetic
 }  // namespace lss
 
@@ -0,0 +1,32 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "base/situation.h"
+#include "genetic/moves.h"
+#include "genetic/permutation_chromosome/chromosome.h"
+#include "genetic/permutation_chromosome/common.h"
+#include "genetic/permutation_chromosome/moves_impl.h"
+#include "greedy_new/algorithm.h"
+
+namespace lss {
+namespace genetic {
+
+Population<PermutationJobMachine> GreedyInitializer::InitPopulation(Situation situation,
+                                                                    int population_size) const {
+  int greedy_size = std::min<int>(std::round(greedy_fraction_ * population_size), population_size);
+  Population<PermutationJobMachine> population;
+  for (int i = 0; i < greedy_size; ++i) {
+    greedy_new::GreedyAlgorithm greedy(i == 0 ? 0. : noise_, rand_);
+    Schedule schedule = greedy.Run(Schedule(), situation);
+    population.push_back(ChromosomeFromSchedule(schedule, situation, rand_.get()));
+  }
+
+  Population<PermutationJobMachine> random =
+      InitializerImpl(rand_).InitPopulation(situation, population_size - greedy_size);
+  std::move(random.begin(), random.end(), std::back_inserter(population));
+  return population;
+}
+
+}  // namespace genetic
+}  // namespace lss
@@ -0,0 +1,84 @@
+#include <memory>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "genetic/permutation_chromosome/common.h"
+#include "genetic/permutation_chromosome/moves_impl.h"
+#include "base/random.h"
+#include "base/situation.h"
+#include "genetic/test_utils.h"
+#include "greedy_new/algorithm.h"
+
+namespace lss {
+namespace genetic {
+
+class GreedyInitializerShould : public ::testing::Test {
+ protected:
+  void SetUp() {
+    rawSituation_ = GetSimpleRawSituation(kNumberOfJobs, kNumberOfMachines);
+    for (size_t i = 0; i < rawSituation_.jobs_.size(); ++i)
+      rawSituation_.jobs_[i].duration(i % 3 + 1);
+    rand_ = std::make_shared<Random>();
+  }
+
+  static void ExpectAllJobs(Situation situation, const PermutationJobMachine &chromosome) {
+    ASSERT_EQ(situation.jobs().size(), chromosome.permutation().size());
+    for (const Job &job : situation.jobs()) {
+      bool found_job_in_permutation = false;
+      for (const JobMachine &jm : chromosome.permutation()) {
+        found_job_in_permutation |= std::get<0>(jm) == job;
+      }
+      ASSERT_TRUE(found_job_in_permutation);
+    }
+  }
+
+  RawSituation rawSituation_;
+  std::shared_ptr<Random> rand_;
+  const int kNumberOfJobs = 7;
+  const int kNumberOfMachines = 3;
+};
+
+TEST_F(GreedyInitializerShould, return_population_of_permutations_with_requested_size) {
+  Situation situation(rawSituation_);
+  const int kPopulationSize = 10;
+
+  GreedyInitializer initializer(rand_, 0.5, 0.2);
+  auto population = initializer.InitPopulation(situation, kPopulationSize);
+
+  ASSERT_EQ(kPopulationSize, population.size());
+  for (PermutationJobMachine &chromosome : population) {
+    ExpectAllJobs(situation, chromosome);
+  }
+}
+
+TEST_F(GreedyInitializerShould, seed_first_chromosome_with_greedy_schedule) {
+  Situation situation(rawSituation_);
+
+  GreedyInitializer initializer(rand_, 0.1, 0.2);
+  auto population = initializer.InitPopulation(situation, 10);
+
+  auto expected = greedy_new::GreedyAlgorithm().Run(Schedule(), situation).GetAssignments();
+  auto actual = population[0].ToSchedule(situation).GetAssignments();
+  for (Machine machine : situation.machines()) {
+    EXPECT_EQ(expected[machine], actual[machine]);
+  }
+}
+
+TEST_F(GreedyInitializerShould, append_jobs_missing_from_schedule) {
+  Situation situation(rawSituation_);
+  Schedule schedule(situation);
+  schedule.AssignJob(situation.machines()[1], situation.jobs()[2]);
+  schedule.AssignJob(situation.machines()[1], situation.jobs()[0]);
+
+  auto chromosome = ChromosomeFromSchedule(schedule, situation, rand_.get());
+
+  ExpectAllJobs(situation, chromosome);
+  EXPECT_EQ(std::make_tuple(situation.jobs()[2], situation.machines()[1]),
+            chromosome.permutation()[0]);
+  EXPECT_EQ(std::make_tuple(situation.jobs()[0], situation.machines()[1]),
+            chromosome.permutation()[1]);
+}
+
+}  // namespace genetic
+}  // namespace lss
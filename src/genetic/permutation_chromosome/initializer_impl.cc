@@ -25,7 +25,7 @@ PermutationJobMachine InitializerImpl::GenNewChromosome(Situation situation) con
   for (Job job : situation.jobs()) {
     jobs_permutation.push_back(job);
   }
-  std::random_shuffle(std::begin(jobs_permutation), std::end(jobs_permutation));
+  rand_->Shuffle(&jobs_permutation);
 
   PermutationJobMachine chromosome;
   for (Job job : jobs_permutation) {
@@ -1,8 +1,12 @@
 #ifndef LSS_GENETIC_PERMUTATION_CHROMOSOME_MOVES_IMPL_H_
 #define LSS_GENETIC_PERMUTATION_CHROMOSOME_MOVES_IMPL_H_
 
+#include <algorithm>
+#include <vector>
+
 #include "genetic/moves.h"
 #include "genetic/permutation_chromosome/chromosome.h"
+#include "genetic/permutation_chromosome/common.h"
 
 namespace lss {
 namespace genetic {
@@ -18,23 +22,47 @@ class InitializerImpl : public Initializer<PermutationJobMachine> {
   PermutationJobMachine GenNewChromosome(Situation situation) const;
 };
 
+// Seeds `greedy_fraction` of the population with greedy_new schedules: the first one
+// deterministic and the others randomized by `noise` (see greedy_new::GreedyAlgorithm).
+// The rest of the population is random, like in InitializerImpl, for diversity.
+class GreedyInitializer : public Initializer<PermutationJobMachine> {
+ public:
+  GreedyInitializer(std::shared_ptr<Random> rand, double greedy_fraction, double noise)
+      : rand_(rand), greedy_fraction_(greedy_fraction), noise_(noise) {}
+  Population<PermutationJobMachine> InitPopulation(Situation situation,
+                                                   int population_size) const override;
+
+ private:
+  std::shared_ptr<Random> rand_;
+  double greedy_fraction_;
+  double noise_;
+};
+
 class EvaluatorImpl : public Evaluator<PermutationJobMachine> {
  public:
+  explicit EvaluatorImpl(double imbalance_factor = 0.) : imbalance_factor_(imbalance_factor) {}
+
   double Evaluate(Situation situation,
                   const PermutationJobMachine &chromosome) const override {
-    return ObjectiveFunction(chromosome.ToSchedule(situation), situation);
+    return ObjectiveFunction(chromosome.ToSchedule(situation), situation, imbalance_factor_);
   }
+
+ private:
+  double imbalance_factor_;
 };
 
+// Mutates every gene with `mutationProbability` by one of `mutations` (see MutatePermutation).
 class MutatorImpl : public Mutator<PermutationJobMachine> {
  public:
-  MutatorImpl(double mutationProbability, std::shared_ptr<Random> rand)
-      : kMutationProbability(mutationProbability), rand_(rand) {}
+  MutatorImpl(double mutationProbability, std::shared_ptr<Random> rand,
+              std::vector<Mutation> mutations = {Mutation::kMachine})
+      : kMutationProbability(mutationProbability), rand_(rand), mutations_(mutations) {}
   void Mutate(Situation situation, PermutationJobMachine *chromosome) const override;
 
  private:
   double kMutationProbability;
   std::shared_ptr<Random> rand_;
+  std::vector<Mutation> mutations_;
 };
 
 class CrosserImpl: public Crosser<PermutationJobMachine> {
@@ -46,6 +74,43 @@ class CrosserImpl: public Crosser<PermutationJobMachine> {
   std::shared_ptr<Random> rand_;
 };
 
+// Statically composed counterparts of MutatorImpl and CrosserImpl for StaticGeneticAlgorithm,
+// holding `Rng` (e.g. FastRandom) by value so that per-gene calls can be inlined.
+template<class Rng>
+class StaticMutator {
+ public:
+  StaticMutator(double mutation_probability, Rng rand,
+                std::vector<Mutation> mutations = {Mutation::kMachine})
+      : mutation_probability_(mutation_probability), rand_(rand), mutations_(mutations) {}
+
+  void Mutate(__attribute__((unused)) Situation situation, PermutationJobMachine *chromosome) {
+    MutatePermutation(mutation_probability_, mutations_, &chromosome->permutation(), &rand_);
+  }
+
+ private:
+  double mutation_probability_;
+  Rng rand_;
+  std::vector<Mutation> mutations_;
+};
+
+template<class Rng>
+class StaticCrosser {
+ public:
+  explicit StaticCrosser(Rng rand) : rand_(rand) {}
+
+  void Crossover(PermutationJobMachine *lhs, PermutationJobMachine *rhs) {
+    size_t permutation_size = lhs->permutation().size();
+    if (permutation_size == 0) return;
+    size_t first_bound = rand_.Rand(permutation_size);
+    size_t second_bound = rand_.Rand(permutation_size);
+    OrderCrossover(&lhs->permutation(), &rhs->permutation(),
+                   std::min(first_bound, second_bound), std::max(first_bound, second_bound));
+  }
+
+ private:
+  Rng rand_;
+};
+
 }  // namespace genetic
 }  // namespace lss
 
@@ -32,10 +32,11 @@ TEST_F(MutatorShould, take_job_machine_to_mutation_wrt_generated_random_number)
   Situation situation(raw_situation_);
   auto permutation = GetPermutation({3, 1, 4, 0, 2}, {0, 1, 1, 0, 0}, situation);
   auto chromosome = PermutationJobMachine(permutation);
-  std::vector<double> randoms = {0.1, 0.6, 0.4, 0.2, 0.6};
+  // Gaps of 0, 1, 0 and then beyond the end: floor(log(1 - u) / log(0.5)).
+  std::vector<double> randoms = {0.1, 0.6, 0.1, 0.9};
   Iterator<double> it(randoms);
   EXPECT_CALL(*rand_, GetRealInRange(0., 1.))
-      .Times(kNumberOfJobs)
+      .Times(4)
       .WillRepeatedly(InvokeWithoutArgs(&it, &Iterator<double>::Next));
   EXPECT_CALL(*rand_, Rand(3)).Times(3).WillRepeatedly(Return(2));
 
@@ -53,7 +54,7 @@ TEST_F(MutatorShould, select_new_machine_for_jobs_wrt_generated_random_number) {
   Situation situation(raw_situation_);
   auto permutation = GetPermutation({3, 1, 4, 0, 2}, {0, 0, 0, 0, 0}, situation);
   auto chromosome = PermutationJobMachine(permutation);
-  EXPECT_CALL(*rand_, GetRealInRange(0., 1.)).Times(kNumberOfJobs).WillRepeatedly(Return(0));
+  EXPECT_CALL(*rand_, GetRealInRange(0., 1.)).Times(0);
 
   std::vector<IdType> expected_machines_order = {1, 2, 0, 1, 2};
   Iterator<IdType> it(expected_machines_order);
@@ -70,5 +71,85 @@ TEST_F(MutatorShould, select_new_machine_for_jobs_wrt_generated_random_number) {
   }
 }
 
+class MutationShould : public MutatorShould {
+ protected:
+  // Mutates the gene at position 1 of jobs {3, 1, 4, 0, 2}, with `other` drawn as
+  // the second position, and returns the resulting order of jobs.
+  std::vector<IdType> MutateSecondGene(std::vector<Mutation> mutations, size_t other) {
+    Situation situation(raw_situation_);
+    auto permutation = GetPermutation({3, 1, 4, 0, 2}, {0, 0, 0, 0, 0}, situation);
+    auto chromosome = PermutationJobMachine(permutation);
+    std::vector<double> randoms = {0.6, 0.9};
+    Iterator<double> it(randoms);
+    EXPECT_CALL(*rand_, GetRealInRange(0., 1.))
+        .Times(2)
+        .WillRepeatedly(InvokeWithoutArgs(&it, &Iterator<double>::Next));
+    EXPECT_CALL(*rand_, Rand(kNumberOfJobs)).WillOnce(Return(other));
+
+    MutatorImpl mutator(0.5, rand_, mutations);
+    mutator.Mutate(situation, &chromosome);
+
+    std::vector<IdType> jobs;
+    for (const JobMachine &gene : chromosome.permutation())
+      jobs.push_back(static_cast<IdType>(std::get<0>(gene).id()));
+    return jobs;
+  }
+};
+
+TEST_F(MutationShould, swap_genes) {
+  EXPECT_EQ(std::vector<IdType>({3, 0, 4, 1, 2}), MutateSecondGene({Mutation::kSwap}, 3));
+}
+
+TEST_F(MutationShould, reverse_genes_between_positions) {
+  EXPECT_EQ(std::vector<IdType>({3, 2, 0, 4, 1}), MutateSecondGene({Mutation::kInversion}, 4));
+  EXPECT_EQ(std::vector<IdType>({1, 3, 4, 0, 2}), MutateSecondGene({Mutation::kInversion}, 0));
+}
+
+TEST_F(MutationShould, insert_gene_at_position) {
+  EXPECT_EQ(std::vector<IdType>({3, 4, 0, 1, 2}), MutateSecondGene({Mutation::kInsert}, 3));
+  EXPECT_EQ(std::vector<IdType>({1, 3, 4, 0, 2}), MutateSecondGene({Mutation::kInsert}, 0));
+}
+
+TEST_F(MutationShould, choose_mutation_uniformly) {
+  EXPECT_CALL(*rand_, Rand(2)).WillOnce(Return(1));
+  EXPECT_EQ(std::vector<IdType>({3, 0, 4, 1, 2}),
+            MutateSecondGene({Mutation::kInversion, Mutation::kSwap}, 3));
+}
+
+// Counts calls of FastRandom to verify the cost of MutatePermutation().
+class CountingRandom {
+ public:
+  double GetRealInRange(double a, double b) {
+    ++reals;
+    return rand.GetRealInRange(a, b);
+  }
+
+  size_t Rand(size_t n) {
+    ++ints;
+    return rand.Rand(n);
+  }
+
+  FastRandom rand{42};
+  int reals = 0;
+  int ints = 0;
+};
+
+TEST_F(MutatorShould, draw_random_numbers_only_for_mutated_genes) {
+  const int kJobs = 100000;
+  Situation situation(GetSimpleRawSituation(kJobs, kNumberOfMachines));
+  std::vector<JobMachine> permutation;
+  for (Job job : situation.jobs())
+    permutation.push_back(std::make_tuple(job, job.machine_set().machines()[0]));
+
+  CountingRandom rand;
+  MutatePermutation(0.01, {Mutation::kMachine}, &permutation, &rand);
+
+  // One machine is drawn per mutation, whose number is binomial with mean 1000 and
+  // standard deviation below 32.
+  EXPECT_NEAR(kJobs * 0.01, rand.ints, 150);
+  EXPECT_EQ(rand.ints + 1, rand.reals);
+  EXPECT_EQ(static_cast<size_t>(kJobs), permutation.size());
+}
+
 }  // namespace genetic
 }  // namespace lss
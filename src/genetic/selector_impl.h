@@ -1,6 +1,8 @@
 #ifndef LSS_GENETIC_SELECTOR_IMPL_H_
 #define LSS_GENETIC_SELECTOR_IMPL_H_
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 #include <vector>
 
@@ -12,6 +14,21 @@
 namespace lss {
 namespace genetic {
 
+// Records `fitnesses` of `population` in `improver` and returns prefix sums of the roulette
+// weights: fitnesses minus the smallest one, so selection does not depend on the sign or offset
+// of fitness (it is negative when the imbalance term dominates the reward). If all fitnesses are
+// equal, weights are uniform.
+template<class T>
+std::vector<double> CumulativeFitness(const Population<T> &population,
+                                      const std::vector<double> &fitnesses,
+                                      ChromosomeImprover<T> *improver);
+
+// Returns the index of the first chromosome whose cumulative fitness is at least `point`.
+inline size_t RouletteIndex(const std::vector<double> &cumulative_fitness, double point) {
+  auto low = std::lower_bound(std::begin(cumulative_fitness), std::end(cumulative_fitness), point);
+  return low - std::begin(cumulative_fitness);
+}
+
 template<class T>
 class SelectorImpl : public Selector<T> {
  public:
@@ -33,6 +50,31 @@ class SelectorImpl : public Selector<T> {
   size_t SelectChromosomeIndex(const std::vector<double> &cumulative_fitness) const;
 };
 
+// Statically composed counterpart of SelectorImpl for StaticGeneticAlgorithm: `Evaluator`
+// and `Rng` (e.g. BatchEvaluator and FastRandom) are held by value, so calls are not virtual.
+template<class T, class Evaluator, class Rng>
+class StaticSelector {
+ public:
+  StaticSelector(Evaluator evaluator, Rng rand) : evaluator_(evaluator), rand_(rand) {}
+
+  Population<T> Select(Situation situation,
+                       const Population<T> &population,
+                       ChromosomeImprover<T> *improver) {
+    std::vector<double> cumulative_fitness =
+        CumulativeFitness(population, evaluator_.EvaluateAll(situation, population), improver);
+    Population<T> new_population;
+    for (size_t i = 0; i < population.size(); ++i) {
+      double point = rand_.GetRealInRange(0, cumulative_fitness.back());
+      new_population.push_back(population[RouletteIndex(cumulative_fitness, point)]);
+    }
+    return new_population;
+  }
+
+ private:
+  Evaluator evaluator_;
+  Rng rand_;
+};
+
 template<class T>
 Population<T> SelectorImpl<T>::Select(Situation situation,
                                       const Population<T> &population,
@@ -50,31 +92,39 @@ template<class T>
 std::vector<double> SelectorImpl<T>::CalcCumulativeFitness(Situation situation,
                                                            const Population<T> &population,
                                                            ChromosomeImprover<T> *improver) const {
-  std::vector<double> fitnesses;
+  return CumulativeFitness(population, kEvaluator->EvaluateAll(situation, population), improver);
+}
+
+template<class T>
+size_t SelectorImpl<T>::SelectChromosomeIndex(const std::vector<double> &cumulative_fitness) const {
+  return RouletteIndex(cumulative_fitness, rand_->GetRealInRange(0, cumulative_fitness.back()));
+}
+
+template<class T>
+std::vector<double> CumulativeFitness(const Population<T> &population,
+                                      const std::vector<double> &fitnesses,
+                                      ChromosomeImprover<T> *improver) {
   ChromosomeImprover<T> population_improver;
-  for (const T &chromosome : population) {
-    double fitness = kEvaluator->Evaluate(situation, chromosome);
-    population_improver.TryImprove(chromosome, fitness);
-    fitnesses.push_back(fitness);
+  for (size_t i = 0; i < population.size(); ++i) {
+    population_improver.TryImprove(population[i], fitnesses[i]);
   }
   improver->TryImprove(population_improver);
+  improver->RecordPopulation(fitnesses);
 
   std::vector<double> cumulative_fitness;
+  if (fitnesses.empty()) return cumulative_fitness;
+  double min_fitness = *std::min_element(std::begin(fitnesses), std::end(fitnesses));
   double accumulator = 0.;
   for (double fitness : fitnesses) {
-    accumulator += fitness;
+    accumulator += fitness - min_fitness;
     cumulative_fitness.push_back(accumulator);
   }
+  if (accumulator > 0.) return cumulative_fitness;
+  for (size_t i = 0; i < cumulative_fitness.size(); ++i)
+    cumulative_fitness[i] = i + 1;
   return cumulative_fitness;
 }
 
-template<class T>
-size_t SelectorImpl<T>::SelectChromosomeIndex(const std::vector<double> &cumulative_fitness) const {
-  double rand = rand_->GetRealInRange(0, cumulative_fitness.back());
-  auto low = std::lower_bound(std::begin(cumulative_fitness), std::end(cumulative_fitness), rand);
-  return low - std::begin(cumulative_fitness);
-}
-
 template<class T>
 void ChromosomeImprover<T>::TryImprove(const T &chromosome, double fitness) {
   if (fitness > best_fitness_) {
@@ -88,6 +138,19 @@ void ChromosomeImprover<T>::TryImprove(const ChromosomeImprover<T> &other) {
   TryImprove(other.GetBestChromosome(), other.GetBestFitness());
 }
 
+template<class T>
+void ChromosomeImprover<T>::RecordPopulation(const std::vector<double> &fitnesses) {
+  if (fitnesses.empty()) return;
+  double sum = 0., square_sum = 0.;
+  for (double fitness : fitnesses) {
+    sum += fitness;
+    square_sum += fitness * fitness;
+  }
+  mean_fitness_ = sum / fitnesses.size();
+  double variance = square_sum / fitnesses.size() - mean_fitness_ * mean_fitness_;
+  fitness_deviation_ = std::sqrt(std::max(variance, 0.));
+}
+
 }  // namespace genetic
 }  // namespace lss
 
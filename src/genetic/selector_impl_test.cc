@@ -58,17 +58,17 @@ TEST_F(SelectorShould, return_population_with_the_same_size) {
 
 TEST_F(SelectorShould, select_chromosomes_to_new_population_according_to_generated_random_numbers) {
   EXPECT_CALL(improver_, TryImprove(_));
-  // Cumulative Fitness: 20, 30, 55, 70
+  // Cumulative Fitness: 10, 10, 25, 30
   EXPECT_CALL(*evaluator_, Evaluate(_, _))
       .WillOnce(Return(20))
       .WillOnce(Return(10))
       .WillOnce(Return(25))
       .WillOnce(Return(15));
-  EXPECT_CALL(*rand_, GetRealInRange(0., 70.))
-      .WillOnce(Return(40))
-      .WillOnce(Return(60))
+  EXPECT_CALL(*rand_, GetRealInRange(0., 30.))
+      .WillOnce(Return(20))
+      .WillOnce(Return(28))
       .WillOnce(Return(5))
-      .WillOnce(Return(30));
+      .WillOnce(Return(10));
 
   SelectorImpl<ChromosomeFake> selector(evaluator_, rand_);
   Population<ChromosomeFake> new_population = selector.Select(situation_, population_, &improver_);
@@ -77,24 +77,24 @@ TEST_F(SelectorShould, select_chromosomes_to_new_population_according_to_generat
       ChromosomeFake(2),
       ChromosomeFake(3),
       ChromosomeFake(0),
-      ChromosomeFake(1)
+      ChromosomeFake(0)
   };
   EXPECT_EQ(expected_population, new_population);
 }
 
 TEST_F(SelectorShould, take_multiple_times_the_same_chromosome_if_random_number_says_so) {
   EXPECT_CALL(improver_, TryImprove(_));
-  // Cumulative Fitness: 20, 30, 55, 70
+  // Cumulative Fitness: 10, 10, 25, 30
   EXPECT_CALL(*evaluator_, Evaluate(_, _))
       .WillOnce(Return(20))
       .WillOnce(Return(10))
       .WillOnce(Return(25))
       .WillOnce(Return(15));
-  EXPECT_CALL(*rand_, GetRealInRange(0., 70.))
-      .WillOnce(Return(40))
-      .WillOnce(Return(50))
+  EXPECT_CALL(*rand_, GetRealInRange(0., 30.))
+      .WillOnce(Return(20))
+      .WillOnce(Return(22))
       .WillOnce(Return(5))
-      .WillOnce(Return(45));
+      .WillOnce(Return(24));
 
   SelectorImpl<ChromosomeFake> selector(evaluator_, rand_);
   Population<ChromosomeFake> new_population = selector.Select(situation_, population_, &improver_);
@@ -108,6 +108,56 @@ TEST_F(SelectorShould, take_multiple_times_the_same_chromosome_if_random_number_
   EXPECT_EQ(expected_population, new_population);
 }
 
+// Fitness is negative when the imbalance term of the objective function dominates the reward.
+TEST_F(SelectorShould, select_the_same_way_if_imbalance_makes_fitness_negative) {
+  ChromosomeImprover<ChromosomeFake> improver;
+  // Cumulative Fitness: 10, 10, 25, 30
+  EXPECT_CALL(*evaluator_, Evaluate(_, _))
+      .WillOnce(Return(-1000))
+      .WillOnce(Return(-1010))
+      .WillOnce(Return(-995))
+      .WillOnce(Return(-1005));
+  EXPECT_CALL(*rand_, GetRealInRange(0., 30.))
+      .WillOnce(Return(20))
+      .WillOnce(Return(28))
+      .WillOnce(Return(5))
+      .WillOnce(Return(10));
+
+  SelectorImpl<ChromosomeFake> selector(evaluator_, rand_);
+  Population<ChromosomeFake> new_population = selector.Select(situation_, population_, &improver);
+
+  Population<ChromosomeFake> expected_population = {
+      ChromosomeFake(2),
+      ChromosomeFake(3),
+      ChromosomeFake(0),
+      ChromosomeFake(0)
+  };
+  EXPECT_EQ(expected_population, new_population);
+  EXPECT_EQ(population_[2], improver.GetBestChromosome());
+  EXPECT_EQ(-995, improver.GetBestFitness());
+}
+
+TEST_F(SelectorShould, select_uniformly_if_all_fitnesses_are_equal) {
+  EXPECT_CALL(improver_, TryImprove(_));
+  EXPECT_CALL(*evaluator_, Evaluate(_, _)).WillRepeatedly(Return(-7));
+  EXPECT_CALL(*rand_, GetRealInRange(0., 4.))
+      .WillOnce(Return(3.5))
+      .WillOnce(Return(0.5))
+      .WillOnce(Return(2.5))
+      .WillOnce(Return(1.5));
+
+  SelectorImpl<ChromosomeFake> selector(evaluator_, rand_);
+  Population<ChromosomeFake> new_population = selector.Select(situation_, population_, &improver_);
+
+  Population<ChromosomeFake> expected_population = {
+      ChromosomeFake(3),
+      ChromosomeFake(0),
+      ChromosomeFake(2),
+      ChromosomeFake(1)
+  };
+  EXPECT_EQ(expected_population, new_population);
+}
+
 TEST_F(SelectorShould, change_improver_to_return_best_chromosome_from_first_population) {
   EXPECT_CALL(*rand_, GetRealInRange(_, _)).Times(kPopulationSize);
   ChromosomeImprover<ChromosomeFake> improver;
@@ -190,10 +240,10 @@ TEST_F(SelectorShould, not_change_improver_if_has_not_found_better_chromosome) {
   EXPECT_EQ(kPrevBestFitness, improver.GetBestFitness());
 }
 
-TEST(ChromosomeImproverShould, return_default_chromosome_and_min_fitness_before_improve) {
+TEST(ChromosomeImproverShould, return_default_chromosome_and_lowest_fitness_before_improve) {
   ChromosomeImprover<ChromosomeFake> improver;
   ASSERT_EQ(ChromosomeFake(), improver.GetBestChromosome());
-  ASSERT_EQ(std::numeric_limits<double>::min(), improver.GetBestFitness());
+  ASSERT_EQ(std::numeric_limits<double>::lowest(), improver.GetBestFitness());
 }
 
 TEST(ChromosomeImproverShould, take_better_chromosome) {
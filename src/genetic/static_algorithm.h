@@ -0,0 +1,118 @@
+#ifndef LSS_GENETIC_STATIC_ALGORITHM_H_
+#define LSS_GENETIC_STATIC_ALGORITHM_H_
+
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "base/algorithm.h"
+#include "base/schedule.h"
+#include "base/situation.h"
+#include "genetic/moves.h"
+
+namespace lss {
+namespace genetic {
+
+// Statically composed counterpart of GeneticAlgorithm. Moves and the random number generator
+// are template parameters held by value, so their calls are not virtual and can be inlined.
+// They need the same methods as Initializer, Selector, Crosser and Mutator (which may be
+// non-const) and, for `Rng`, GetRealInRange() and RandomShuffle() (see FastRandom).
+// GeneticAlgorithm is an instance with mockable virtual moves.
+template<class T, class Initializer, class Selector, class Crosser, class Mutator, class Rng>
+class StaticGeneticAlgorithm : public Algorithm {
+ public:
+  StaticGeneticAlgorithm(int population_size,
+                         int number_of_generations,
+                         double crossover_probability,
+                         Initializer initializer,
+                         Selector selector,
+                         Crosser crosser,
+                         Mutator mutator,
+                         Rng rand)
+      : population_size_(population_size),
+        number_of_generations_(number_of_generations),
+        crossover_probability_(crossover_probability),
+        initializer_(std::move(initializer)),
+        selector_(std::move(selector)),
+        crosser_(std::move(crosser)),
+        mutator_(std::move(mutator)),
+        rand_(std::move(rand)) {}
+
+  Schedule Run(const Schedule &prev_schedule, Situation new_situation) override;
+
+ private:
+  void Crossover(Population<T> *population);
+
+  int population_size_;
+  int number_of_generations_;
+  double crossover_probability_;
+  Initializer initializer_;
+  Selector selector_;
+  Crosser crosser_;
+  Mutator mutator_;
+  Rng rand_;
+};
+
+template<class T, class Initializer, class Selector, class Crosser, class Mutator, class Rng>
+Schedule StaticGeneticAlgorithm<T, Initializer, Selector, Crosser, Mutator, Rng>::Run(
+    __attribute__((unused)) const Schedule &prev_schedule, Situation new_situation) {
+  ChromosomeImprover<T> improver;
+  Population<T> population = initializer_.InitPopulation(new_situation, population_size_);
+  auto start = std::chrono::steady_clock::now();
+  double published_fitness = -std::numeric_limits<double>::infinity();
+  for (int generation = 0; generation < number_of_generations_ && !DeadlinePassed();
+       ++generation) {
+    population = selector_.Select(new_situation, population, &improver);
+    Crossover(&population);
+    for (T &chromosome : population)
+      mutator_.Mutate(new_situation, &chromosome);
+
+    // Fitnesses of the evaluator are only used to skip chromosomes which did not improve or
+    // do not beat the incumbent, the incumbent scores schedules with ObjectiveFunction().
+    if (this->incumbent() && improver.GetBestFitness() > published_fitness
+        && improver.GetBestFitness() > this->incumbent()->best_fitness()) {
+      published_fitness = improver.GetBestFitness();
+      this->PublishToIncumbent(improver.GetBestChromosome().ToSchedule(new_situation),
+                               new_situation);
+    }
+    if (Trace *trace = this->trace()) {
+      auto now = std::chrono::steady_clock::now();
+      TracePoint point;
+      point.step = generation;
+      point.best = improver.GetBestFitness();
+      point.current = improver.GetMeanFitness();
+      point.diversity = improver.GetFitnessDeviation();
+      point.nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+      trace->Add(point);
+      start = now;
+    }
+  }
+  this->FlushTrace("genetic");
+  return improver.GetBestChromosome().ToSchedule(new_situation);
+}
+
+template<class T, class Initializer, class Selector, class Crosser, class Mutator, class Rng>
+void StaticGeneticAlgorithm<T, Initializer, Selector, Crosser, Mutator, Rng>::Crossover(
+    Population<T> *population) {
+  std::vector<size_t> indexes(population->size());
+  std::iota(std::begin(indexes), std::end(indexes), 0);
+  rand_.RandomShuffle(&indexes);
+  T *chromosome_waiting_for_crossover = nullptr;
+  for (size_t i = 0; i < population->size(); ++i) {
+    if (rand_.GetRealInRange(0., 1.) >= crossover_probability_)
+      continue;
+    if (chromosome_waiting_for_crossover) {
+      crosser_.Crossover(chromosome_waiting_for_crossover, &(*population)[indexes[i]]);
+      chromosome_waiting_for_crossover = nullptr;
+    } else {
+      chromosome_waiting_for_crossover = &(*population)[indexes[i]];
+    }
+  }
+}
+
+}  // namespace genetic
+}  // namespace lss
+
+#endif  // LSS_GENETIC_STATIC_ALGORITHM_H_
@@ -0,0 +1,192 @@
+#include "genetic/static_algorithm.h"
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "base/incumbent.h"
+#include "base/random.h"
+#include "genetic/algorithm.h"
+#include "genetic/permutation_chromosome/moves_impl.h"
+#include "genetic/selector_impl.h"
+#include "genetic/test_utils.h"
+
+namespace lss {
+namespace genetic {
+namespace {
+
+using ::testing::_;
+using ::testing::Invoke;
+
+// Moves are held by value by StaticGeneticAlgorithm, so the fakes record calls through
+// shared logs.
+using CrossoverArgs = std::tuple<ChromosomeFake, ChromosomeFake>;
+
+class InitializerFake {
+ public:
+  Population<ChromosomeFake> InitPopulation(__attribute__((unused)) Situation situation,
+                                            int population_size) {
+    Population<ChromosomeFake> population;
+    for (int i = 0; i < population_size; ++i)
+      population.push_back(ChromosomeFake(i));
+    return population;
+  }
+};
+
+class SelectorFake {
+ public:
+  explicit SelectorFake(std::shared_ptr<int> calls) : calls_(calls) {}
+
+  Population<ChromosomeFake> Select(
+      __attribute__((unused)) Situation situation,
+      const Population<ChromosomeFake> &population,
+      ChromosomeImprover<ChromosomeFake> *improver) {
+    ++*calls_;
+    improver->TryImprove(population.front(), 100. + *calls_);
+    return population;
+  }
+
+ private:
+  std::shared_ptr<int> calls_;
+};
+
+class CrosserFake {
+ public:
+  explicit CrosserFake(std::shared_ptr<std::vector<CrossoverArgs>> args) : args_(args) {}
+
+  void Crossover(ChromosomeFake *lhs, ChromosomeFake *rhs) {
+    args_->push_back(std::make_tuple(*lhs, *rhs));
+  }
+
+ private:
+  std::shared_ptr<std::vector<CrossoverArgs>> args_;
+};
+
+class MutatorFake {
+ public:
+  explicit MutatorFake(std::shared_ptr<std::vector<ChromosomeFake>> invoked)
+      : invoked_(invoked) {}
+
+  void Mutate(__attribute__((unused)) Situation situation, ChromosomeFake *chromosome) {
+    invoked_->push_back(*chromosome);
+  }
+
+ private:
+  std::shared_ptr<std::vector<ChromosomeFake>> invoked_;
+};
+
+// Returns the given numbers from GetRealInRange() and does not shuffle.
+class RandomFake {
+ public:
+  explicit RandomFake(std::vector<double> randoms) : it_(randoms) {}
+
+  double GetRealInRange(__attribute__((unused)) double a, __attribute__((unused)) double b) {
+    return it_.Next();
+  }
+
+  template<class T>
+  void RandomShuffle(__attribute__((unused)) std::vector<T> *v) {}
+
+ private:
+  Iterator<double> it_;
+};
+
+using FakeAlgorithm = StaticGeneticAlgorithm<ChromosomeFake, InitializerFake, SelectorFake,
+                                             CrosserFake, MutatorFake, RandomFake>;
+
+class StaticAlgorithmShould : public ::testing::Test {
+ protected:
+  StaticAlgorithmShould() : situation_(RawSituation(), false) {}
+
+  FakeAlgorithm BuildAlgorithm(std::vector<double> randoms) {
+    return FakeAlgorithm(population_size_, number_of_generations_, crossover_probability_,
+                         InitializerFake(), SelectorFake(select_calls_),
+                         CrosserFake(crossover_args_), MutatorFake(mutated_),
+                         RandomFake(randoms));
+  }
+
+  int population_size_ = 5;
+  int number_of_generations_ = 1;
+  double crossover_probability_ = 0.5;
+  std::shared_ptr<int> select_calls_ = std::make_shared<int>(0);
+  std::shared_ptr<std::vector<CrossoverArgs>> crossover_args_ =
+      std::make_shared<std::vector<CrossoverArgs>>();
+  std::shared_ptr<std::vector<ChromosomeFake>> mutated_ =
+      std::make_shared<std::vector<ChromosomeFake>>();
+  Schedule schedule_;
+  Situation situation_;
+};
+
+TEST_F(StaticAlgorithmShould, select_and_mutate_every_chromosome_in_each_generation) {
+  number_of_generations_ = 3;
+  FakeAlgorithm algorithm = BuildAlgorithm(std::vector<double>(15, 1.));
+
+  std::vector<TracePoint> points;
+  auto sink = std::make_shared<TraceSinkMock>();
+  EXPECT_CALL(*sink, Flush("genetic", 0, _))
+      .WillOnce(Invoke([&points](const std::string &, int64_t, const Trace &trace) {
+        points = trace.Points();
+      }));
+  algorithm.SetTraceSink(sink);
+  algorithm.Run(schedule_, situation_);
+
+  EXPECT_EQ(number_of_generations_, *select_calls_);
+  EXPECT_EQ(number_of_generations_ * population_size_, mutated_->size());
+  EXPECT_TRUE(crossover_args_->empty());
+  EXPECT_EQ(number_of_generations_, points.size());
+}
+
+TEST_F(StaticAlgorithmShould, take_chromosomes_to_crossover_according_to_generated_random_number) {
+  FakeAlgorithm algorithm = BuildAlgorithm({0.2, 0.6, 0.3, 0.1, 0.2});
+  algorithm.Run(schedule_, situation_);
+
+  ASSERT_EQ(2, crossover_args_->size());
+  EXPECT_EQ(std::make_tuple(ChromosomeFake(0), ChromosomeFake(2)), (*crossover_args_)[0]);
+  EXPECT_EQ(std::make_tuple(ChromosomeFake(3), ChromosomeFake(4)), (*crossover_args_)[1]);
+}
+
+TEST_F(StaticAlgorithmShould, publish_best_chromosomes_scored_with_objective_function) {
+  number_of_generations_ = 2;
+  FakeAlgorithm algorithm = BuildAlgorithm(std::vector<double>(10, 1.));
+  auto incumbent = std::make_shared<Incumbent>();
+  algorithm.SetIncumbent(incumbent);
+  Schedule schedule = algorithm.Run(schedule_, situation_);
+
+  auto snapshot = incumbent->Get();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_EQ(ObjectiveFunction(schedule, situation_), snapshot->fitness);
+  EXPECT_EQ(1, snapshot->version);
+}
+
+// Verify that permutation moves composed with FastRandom give the same schedule for
+// the same seed.
+TEST(StaticPermutationAlgorithmShould, be_deterministic_for_a_seed) {
+  RawSituation raw_situation = GetSimpleRawSituation(20, 4);
+  raw_situation.batches_[0].duration(10).job_reward(1);
+  Situation situation(raw_situation, false);
+  using Algorithm = StaticGeneticAlgorithm<
+      PermutationJobMachine, InitializerImpl,
+      StaticSelector<PermutationJobMachine, EvaluatorImpl, FastRandom>,
+      StaticCrosser<FastRandom>, StaticMutator<FastRandom>, FastRandom>;
+  auto run = [&situation](uint64_t seed) {
+    FastRandom rand(seed);
+    Algorithm algorithm(10, 5, 0.5, InitializerImpl(std::make_shared<Random>(seed)),
+                        {EvaluatorImpl(), rand.Split()}, StaticCrosser<FastRandom>(rand.Split()),
+                        StaticMutator<FastRandom>(0.1, rand.Split()), rand.Split());
+    return algorithm.Run(Schedule(), situation);
+  };
+
+  Schedule schedule = run(7);
+  EXPECT_TRUE(schedule.GetAssignments() == run(7).GetAssignments());
+  size_t jobs = 0;
+  for (const auto &assignment : schedule.GetAssignments())
+    jobs += assignment.second.size();
+  EXPECT_EQ(situation.jobs().size(), jobs);
+}
+
+}  // namespace
+}  // namespace genetic
+}  // namespace lss
@@ -3,10 +3,10 @@
 #include <algorithm>
 #include <iostream>
 #include <ctime>
-#include <cmath>
 #include <limits>
 
 #include "base/raw_situation.h"
+#include "base/sigmoid.h"
 
 namespace lss {
 namespace greedy {
@@ -28,7 +28,7 @@ double BatchWrapper::Evaluate(std::time_t time) const {
 
 double BatchWrapper::RewardAt(std::time_t time) const {
   double r = (time - raw_batch_.due_) / raw_batch_.duration_;
-  return raw_batch_.reward_ + raw_batch_.timely_reward_ / (1 + exp(r));
+  return raw_batch_.reward_ + raw_batch_.timely_reward_ * Sigmoid(r);
 }
 
 void BatchWrapper::AddJob(const RawJob& raw_job) {
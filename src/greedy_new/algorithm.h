@@ -1,38 +1,53 @@
 #ifndef LSS_GREEDY_NEW_ALGORITHM_H_
 #define LSS_GREEDY_NEW_ALGORITHM_H_
 
+#include <memory>
 #include <unordered_set>
 
 #include "glog/logging.h"
 
 #include "base/algorithm.h"
+#include "base/random.h"
 #include "greedy_new/batch_wrapper.h"
+#include "greedy_new/machine_index.h"
 
 namespace lss {
 namespace greedy_new {
 
 class GreedyAlgorithm: public Algorithm {
  public:
+  GreedyAlgorithm() = default;
+  // Randomized (GRASP-style) variant: evaluations of batches are multiplied by random
+  // factors from [1 - noise, 1 + noise] before ordering them.
+  GreedyAlgorithm(double noise, std::shared_ptr<Random> rand) : noise_(noise), rand_(rand) {}
+
   Schedule Run(__attribute__((unused)) const Schedule &prev_schedule,
                Situation new_situation) override {
-    return Runner(new_situation).Run();
+    Schedule schedule = Runner(new_situation, noise_, rand_.get()).Run();
+    PublishToIncumbent(schedule, new_situation);
+    return schedule;
   }
 
  private:
   class Runner {
    public:
-    explicit Runner(Situation situation) : situation_(situation) {}
+    Runner(Situation situation, double noise, Random *rand)
+        : schedule_(situation), situation_(situation), machines_(situation), noise_(noise),
+          rand_(rand) {}
     Schedule Run();
 
    private:
     void AssignJobsFromBatch(const BatchWrapper &batchWrapper);
-    Machine FindBestMachine(Job job) const;
 
     Schedule schedule_;
     Situation situation_;
-    std::unordered_map<Machine, Time> available_at_;
-    std::unordered_map<Machine, Context> last_context_;
+    MachineIndex machines_;
+    double noise_;
+    Random *rand_;
   };
+
+  double noise_ = 0.;
+  std::shared_ptr<Random> rand_;
 };
 
 
@@ -3,10 +3,10 @@
 #include <algorithm>
 #include <iostream>
 #include <ctime>
-#include <cmath>
 #include <limits>
 
 #include "base/raw_situation.h"
+#include "base/sigmoid.h"
 
 namespace lss {
 namespace greedy_new {
@@ -29,7 +29,7 @@ double BatchWrapper::Evaluate(std::time_t time) const {
 
 double BatchWrapper::RewardAt(std::time_t time) const {
   double r = (time - batch_.due()) / batch_.duration();
-  return batch_.reward() + batch_.timely_reward() / (1 + exp(r));
+  return batch_.reward() + batch_.timely_reward() * Sigmoid(r);
 }
 
 const std::set<Job, JobDurationCmp>& BatchWrapper::GetSortedJobs() const {
@@ -11,9 +11,11 @@
 namespace lss {
 namespace greedy_new {
 
+// Jobs of equal duration are ordered by id, so that none of them is dropped.
 struct JobDurationCmp {
   bool operator()(Job job1, Job job2) const {
-    return job1.duration() < job2.duration();
+    return job1.duration() < job2.duration()
+        || (job1.duration() == job2.duration() && job1.id() < job2.id());
   }
 };
 
@@ -38,18 +40,6 @@ class BatchWrapper {
   std::set<Job, JobDurationCmp> jobs_;
 };
 
-class BatchRewardCmp {
- public:
-  BatchRewardCmp() : time_(std::time(nullptr)) { }
-
-  bool operator()(BatchWrapper lhs, BatchWrapper rhs) {
-    return lhs.Evaluate(time_) < rhs.Evaluate(time_);
-  }
-
- private:
-  std::time_t time_;
-};
-
 }  // namespace greedy_new
 }  // namespace lss
 
@@ -0,0 +1,119 @@
+#include "greedy_new/machine_index.h"
+
+#include <limits>
+
+namespace lss {
+namespace greedy_new {
+
+MachineIndex::MachineIndex(Situation situation) : situation_(situation) {
+  for (int d = 0; d < Change::kNum; ++d)
+    costs_[d] = situation.change_costs().cost(Change(d & 1, d & 2, d & 4));
+
+  buckets_.resize(situation.machine_sets().size());
+
+  for (Machine machine : situation.machines()) {
+    int index = machine.index();
+    machine_sets_.emplace_back();
+    for (MachineSet set : machine.machine_sets())
+      machine_sets_.back().push_back(set.index());
+    available_at_.push_back(machine.free_time());
+    Job running = machine.job();
+    context_.push_back(running ? running.context() : machine.context());
+    if (machine.alive())
+      Insert(index);
+  }
+}
+
+Machine MachineIndex::FindBest(Job job) const {
+  MachineSet set = job.machine_set();
+  if (!set)
+    return Machine();
+
+  const Buckets &buckets = buckets_[set.index()];
+  Context context = job.context();
+  Time best_time = std::numeric_limits<Time>::max();
+  int best = -1;
+  // The most specific buckets first, as they are likely to contain cheap machines.
+  for (int mask = Change::kNum - 1; mask >= 0; --mask) {
+    for (int none = 0; none < Change::kNum; ++none) {
+      if (none & mask)
+        continue;
+      const auto &keys = buckets[BucketIndex(none, mask)];
+      if (keys.empty())
+        continue;
+      auto bucket = keys.find(Project(context, mask));
+      if (bucket == keys.end())
+        continue;
+      // Unknown components are not changed, see ChangeCosts::setup_cost().
+      Cost cost = costs_[~(mask | none) & (Change::kNum - 1)];
+      // Machines matching more components than `mask` are found in their own buckets.
+      for (const Entry &entry : bucket->second) {
+        if (entry.first + cost >= best_time)
+          break;
+        if ((EqualMask(context_[entry.second], context) & ~none) == mask) {
+          best_time = entry.first + cost;
+          best = entry.second;
+          break;
+        }
+      }
+    }
+  }
+  return best < 0 ? Machine() : situation_.machines()[best];
+}
+
+Time MachineIndex::StartTime(Machine machine, Job job) const {
+  int index = machine.index();
+  return available_at_[index]
+      + situation_.change_costs().setup_cost(context_[index], job.context());
+}
+
+void MachineIndex::Update(Machine machine, Time available_at, Context context) {
+  int index = machine.index();
+  Erase(index);
+  available_at_[index] = available_at;
+  context_[index] = context;
+  Insert(index);
+}
+
+Context MachineIndex::Project(Context context, int mask) {
+  Context result;
+  for (int i = 0; i < Context::kSize; ++i)
+    if (mask & (1 << i)) result[i] = context[i];
+  return result;
+}
+
+int MachineIndex::EqualMask(Context lhs, Context rhs) {
+  int mask = 0;
+  for (int i = 0; i < Context::kSize; ++i)
+    if (lhs[i] == rhs[i]) mask |= 1 << i;
+  return mask;
+}
+
+int MachineIndex::NoneMask(Context context) {
+  int mask = 0;
+  for (int i = 0; i < Context::kSize; ++i)
+    if (context[i] == Context::kNone) mask |= 1 << i;
+  return mask;
+}
+
+// Unknown components of a machine's context match any job, so they are never a part of keys.
+void MachineIndex::Insert(int machine) {
+  Entry entry(available_at_[machine], machine);
+  int none = NoneMask(context_[machine]);
+  for (int set : machine_sets_[machine])
+    for (int mask = 0; mask < Change::kNum; ++mask)
+      if (!(mask & none))
+        buckets_[set][BucketIndex(none, mask)][Project(context_[machine], mask)].insert(entry);
+}
+
+void MachineIndex::Erase(int machine) {
+  Entry entry(available_at_[machine], machine);
+  int none = NoneMask(context_[machine]);
+  for (int set : machine_sets_[machine])
+    for (int mask = 0; mask < Change::kNum; ++mask)
+      if (!(mask & none))
+        buckets_[set][BucketIndex(none, mask)][Project(context_[machine], mask)].erase(entry);
+}
+
+}  // namespace greedy_new
+}  // namespace lss
@@ -0,0 +1,66 @@
+#ifndef LSS_GREEDY_NEW_MACHINE_INDEX_H_
+#define LSS_GREEDY_NEW_MACHINE_INDEX_H_
+
+#include <array>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/situation.h"
+
+namespace lss {
+namespace greedy_new {
+
+// Keeps the time at which every alive machine becomes available and its current context,
+// and finds the machine of a machine set on which a job can start earliest.
+//
+// The setup cost of a job (see ChangeCosts::setup_cost()) depends only on which context
+// components of the machine differ from the job's ones and which of them are unknown
+// (Context::kNone), so for every machine set, every mask of unknown components and every mask
+// of equal known components there is a bucket of machines keyed by their context restricted
+// to the latter mask, ordered by availability. FindBest() looks up the buckets matching the job
+// and stops scanning each one as soon as it cannot improve the best start time, which makes it
+// logarithmic in the number of machines unless change costs favour changing context over
+// keeping it.
+class MachineIndex {
+ public:
+  // Machines start at Machine::free_time() in the context of their running job, if any.
+  explicit MachineIndex(Situation situation);
+
+  // Returns null Machine if no machine of the job's machine set is alive.
+  Machine FindBest(Job job) const;
+
+  Time StartTime(Machine machine, Job job) const;
+
+  // Sets the state of `machine` after running a job which finishes at `available_at`.
+  void Update(Machine machine, Time available_at, Context context);
+
+ private:
+  using Entry = std::pair<Time, int>;  // Availability and machine index.
+  // Indexed by `BucketIndex()`.
+  using Buckets =
+      std::array<std::unordered_map<Context, std::set<Entry>>, Change::kNum * Change::kNum>;
+
+  static int BucketIndex(int none_mask, int equal_mask) {
+    return none_mask * Change::kNum + equal_mask;
+  }
+  static Context Project(Context context, int mask);
+  static int EqualMask(Context lhs, Context rhs);
+  static int NoneMask(Context context);
+
+  void Insert(int machine);
+  void Erase(int machine);
+
+  Situation situation_;
+  std::array<Cost, Change::kNum> costs_;
+  std::vector<std::vector<int>> machine_sets_;  // Per machine.
+  std::vector<Time> available_at_;
+  std::vector<Context> context_;
+  std::vector<Buckets> buckets_;  // Per MachineSet::index().
+};
+
+}  // namespace greedy_new
+}  // namespace lss
+
+#endif  // LSS_GREEDY_NEW_MACHINE_INDEX_H_
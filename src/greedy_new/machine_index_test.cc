@@ -0,0 +1,78 @@
+#include "greedy_new/machine_index.h"
+
+#include <limits>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "base/raw_situation.h"
+
+namespace lss {
+namespace greedy_new {
+namespace {
+
+constexpr int kNone = Context::kNone;
+
+// Machines of a single machine set and jobs with the given contexts. A change of
+// component `i` costs 10^i, so changing the last component is the most expensive.
+RawSituation Sample(const std::vector<Context> &machines, const std::vector<Context> &jobs) {
+  RawSituation raw = RawSituation()
+      .add(RawAccount().id(0))
+      .add(RawBatch().id(0).account(0).duration(1));
+  RawMachineSet set = RawMachineSet().id(0);
+  for (size_t i = 0; i < machines.size(); ++i) {
+    raw.add(RawMachine().id(i).state(MachineState::kIdle).context(machines[i]));
+    set.add(i);
+  }
+  raw.add(set);
+  for (size_t i = 0; i < jobs.size(); ++i)
+    raw.add(RawJob().id(i).batch(0).machine_set(0).duration(1 + i % 3).context(jobs[i]));
+  for (int d = 0; d < Change::kNum; ++d)
+    raw.add(RawChangeCost().change(Change(d & 1, d & 2, d & 4)).cost((d & 1) + 10 * !!(d & 2)
+                                                                    + 100 * !!(d & 4)));
+  return raw;
+}
+
+// Verify that unknown components of a machine's context are not charged, like in
+// ChangeCosts::setup_cost().
+TEST(MachineIndexTest, UnknownContextIsNotChanged) {
+  Situation situation(Sample({Context(kNone, kNone, kNone), Context(1, 2, 4)},
+                             {Context(1, 2, 3)}));
+  MachineIndex index(situation);
+  Job job = situation.jobs()[0];
+  Machine best = index.FindBest(job);
+  EXPECT_EQ(situation.machines()[0], best);
+  EXPECT_EQ(best.free_time(), index.StartTime(best, job));
+}
+
+// Verify that FindBest() agrees with a scan of all machines as machines are updated.
+TEST(MachineIndexTest, FindsEarliestStart) {
+  std::mt19937 random(7);
+  auto component = [&random]() {
+    int value = random() % 3;
+    return value == 2 ? kNone : value;
+  };
+  auto context = [&component]() { return Context(component(), component(), component()); };
+  std::vector<Context> machines, jobs;
+  for (int i = 0; i < 20; ++i)
+    machines.push_back(context());
+  for (int i = 0; i < 300; ++i)
+    jobs.push_back(context());
+  Situation situation(Sample(machines, jobs));
+  MachineIndex index(situation);
+
+  for (Job job : situation.jobs()) {
+    Time expected = std::numeric_limits<Time>::max();
+    for (Machine machine : situation.machines())
+      expected = std::min(expected, index.StartTime(machine, job));
+    Machine best = index.FindBest(job);
+    ASSERT_TRUE(static_cast<bool>(best));
+    Time start = index.StartTime(best, job);
+    ASSERT_EQ(expected, start);
+    index.Update(best, start + job.duration(), job.context());
+  }
+}
+
+}  // namespace
+}  // namespace greedy_new
+}  // namespace lss
@@ -1,29 +1,35 @@
 #include "glog/logging.h"
 
+#include <algorithm>
+
+#include "base/stats.h"
 #include "io/assignment_handler.h"
 
 namespace lss {
 namespace io {
+namespace {
+
+// Situation sorts records by ids anyway, and the input usually is sorted already.
+template<class T>
+void SortById(std::vector<T> *records) {
+  auto id_less = [](const T &lhs, const T &rhs) { return lhs.id_ < rhs.id_; };
+  if (!std::is_sorted(records->begin(), records->end(), id_less)) {
+    std::sort(records->begin(), records->end(), id_less);
+  }
+}
+
+}  // namespace
 
 void AssignmentsHandler::AdjustRawSituation(RawSituation *raw_situation) {
+  SortById(&raw_situation->jobs_);
+  SortById(&raw_situation->machines_);
   assignments_state_.UpdateTakenJobs();
   assignments_state_.RemoveNotPresentJobs(*raw_situation);
   assignments_state_.RemoveNotPresentMachines(*raw_situation);
-  RemoveAlreadyTakenJobs(raw_situation);
+  assignments_state_.RemoveTakenJobs(raw_situation);
   FillMachineContexts(raw_situation);
 }
 
-void AssignmentsHandler::RemoveAlreadyTakenJobs(RawSituation *raw_situation) {
-  std::vector<RawJob> filtered_raw_jobs;
-  for (const RawJob &raw_job : raw_situation->jobs_) {
-    if (assignments_state_.KnownJobState(Id<Job>(raw_job.id_)) == JobState::kTaken) {
-      continue;
-    }
-    filtered_raw_jobs.push_back(raw_job);
-  }
-  raw_situation->jobs_ = filtered_raw_jobs;
-}
-
 void AssignmentsHandler::FillMachineContexts(RawSituation *raw_situation) {
   for (RawMachine &raw_machine : raw_situation->machines_) {
     Context context = assignments_state_.GetMachineContext(Id<Machine>(raw_machine.id_));
@@ -32,10 +38,11 @@ void AssignmentsHandler::FillMachineContexts(RawSituation *raw_situation) {
 }
 
 void AssignmentsHandler::AdjustAssignments(const Schedule &schedule) {
-  for (const auto &assignment : schedule.GetAssignments()) {
-    Machine machine = assignment.first;
-    auto jobs = assignment.second;
-    Job job_to_assign = FindJobToAssign(jobs);
+  for (size_t queue = 0; queue < schedule.queue_count(); ++queue) {
+    Machine machine = schedule.machine(queue);
+    if (IsAlreadyAssigned(machine, schedule.jobs(queue)))
+      continue;
+    Job job_to_assign = FindJobToAssign(schedule.jobs(queue));
     if (job_to_assign) {
       assignments_state_.TryUnassign(machine.id());
       assignments_state_.TryAssign(machine.id(), job_to_assign);
@@ -44,48 +51,66 @@ void AssignmentsHandler::AdjustAssignments(const Schedule &schedule) {
 }
 
 void AssignmentsState::UpdateTakenJobs() {
-  // HasTakenAJob() can remove assignment from machines_assignments
-  // so simple range for loop is not sufficient
-  auto machine_assignment = machines_assignments_.begin();
-  while (machine_assignment != machines_assignments_.end()) {
-    HasTakenAJob((machine_assignment++)->first);
-  }
+  machines_.ForEach([this](Id<Machine> machine_id, KnownMachine &machine) {
+    if (machine.job) {
+      HasTakenAJob(machine_id, &machine);
+    }
+  });
 }
 
 void AssignmentsState::RemoveNotPresentJobs(const RawSituation &raw_situation) {
-  std::unordered_set<Id<Job>> jobs;
-  for (const RawJob &raw_job : raw_situation.jobs_) {
-    jobs.insert(Id<Job>(raw_job.id_));
-  }
-  auto job_state = taken_jobs_.begin();
-  while (job_state != taken_jobs_.end()) {
-    if (jobs.count(*job_state) == 0) {
-      taken_jobs_.erase(job_state++);
-    } else {
-      ++job_state;
+  auto raw_job = raw_situation.jobs_.begin();
+  taken_jobs_.EraseIf([&](Id<Job> job_id) {
+    while (raw_job != raw_situation.jobs_.end() && Id<Job>(raw_job->id_) < job_id) {
+      ++raw_job;
     }
-  }
+    return raw_job == raw_situation.jobs_.end() || Id<Job>(raw_job->id_) != job_id;
+  });
 }
 
 void AssignmentsState::RemoveNotPresentMachines(const RawSituation &raw_situation) {
-  std::unordered_set<Id<Machine>> machines;
-  for (const RawMachine &raw_machine : raw_situation.machines_) {
-    machines.insert(Id<Machine>(raw_machine.id_));
-  }
-  auto machine_assignment = machines_assignments_.begin();
-  while (machine_assignment != machines_assignments_.end()) {
-    Id<Machine> machine_id = machine_assignment->first;
-    if (machines.count(machine_id) == 0) {
-      TryUnassign((machine_assignment++)->first);
-      machines_contexts_.erase(machine_id);
-      machines_next_contexts_.erase(machine_id);
-    } else {
-      ++machine_assignment;
+  auto raw_machine = raw_situation.machines_.begin();
+  machines_.EraseIf([&](Id<Machine> machine_id, KnownMachine &machine) {
+    while (raw_machine != raw_situation.machines_.end()
+           && Id<Machine>(raw_machine->id_) < machine_id) {
+      ++raw_machine;
+    }
+    bool present = raw_machine != raw_situation.machines_.end()
+        && Id<Machine>(raw_machine->id_) == machine_id;
+    if (!present && machine.job) {
+      TryUnassign(machine_id, &machine);
+      machine.has_context = false;
+      machine.has_next_context = false;
+    }
+    return machine.empty();
+  });
+}
+
+void AssignmentsState::RemoveTakenJobs(RawSituation *raw_situation) {
+  std::vector<RawJob> &raw_jobs = raw_situation->jobs_;
+  size_t next = 0, kept = 0;
+  taken_jobs_.ForEach([&](Id<Job> job_id) {
+    for (; next < raw_jobs.size() && Id<Job>(raw_jobs[next].id_) <= job_id; ++next) {
+      if (Id<Job>(raw_jobs[next].id_) != job_id) {
+        raw_jobs[kept++] = raw_jobs[next];
+      }
     }
+  });
+  for (; next < raw_jobs.size(); ++next) {
+    raw_jobs[kept++] = raw_jobs[next];
+  }
+  raw_jobs.resize(kept);
+}
+
+bool AssignmentsHandler::IsAlreadyAssigned(Machine machine, Schedule::JobSpan jobs) {
+  for (Job job : jobs) {
+    if (assignments_state_.KnownJobState(job.id()) != JobState::kTaken)
+      return assignments_state_.GetAssignedMachineId(job.id()) == machine.id();
   }
+  return false;
 }
 
-Job AssignmentsHandler::FindJobToAssign(const Schedule::Jobs &jobs) {
+Job AssignmentsHandler::FindJobToAssign(Schedule::JobSpan jobs) {
   Job job_to_assign;
   for (Job job : jobs) {
     if (CanBeAssigned(job)) {
@@ -105,31 +130,35 @@ bool AssignmentsHandler::CanBeAssigned(Job job) {
 }
 
 bool AssignmentsState::TryUnassign(Id<Machine> machine_id) {
-  auto pending_assignment = machines_assignments_.find(machine_id);
-  if (pending_assignment == machines_assignments_.end()) {
+  KnownMachine *machine = machines_.Find(machine_id);
+  return machine && TryUnassign(machine_id, machine);
+}
+
+bool AssignmentsState::TryUnassign(Id<Machine> machine_id, KnownMachine *machine) {
+  if (!machine->job) {
     return false;
   }
-  Id<Job> job_id = pending_assignment->second;
+  Id<Job> job_id = machine->job;
 
-  machines_assignments_.erase(pending_assignment);
-  jobs_assignments_.erase(job_id);
+  machine->job = Id<Job>();
+  pending_jobs_.Erase(job_id);
   bool successful_unassigned = writer_->Unassign(static_cast<IdType>(machine_id));
   if (!successful_unassigned) {
-    taken_jobs_.insert(job_id);
-    SwitchContext(machine_id);
+    taken_jobs_.Insert(job_id);
+    SwitchContext(machine);
   }
   return successful_unassigned;
 }
 
 Id<Machine> AssignmentsState::GetAssignedMachineId(Id<Job> job_id) {
-  auto job_assignment = jobs_assignments_.find(job_id);
-  return job_assignment != jobs_assignments_.end() ? job_assignment->second : Id<Machine>();
+  const Id<Machine> *machine_id = pending_jobs_.Find(job_id);
+  return machine_id ? *machine_id : Id<Machine>();
 }
 
 JobState AssignmentsState::KnownJobState(Id<Job> job_id) {
-  if (jobs_assignments_.count(job_id)) {
+  if (pending_jobs_.Contains(job_id)) {
     return JobState::kAssigned;
-  } else if (taken_jobs_.count(job_id)) {
+  } else if (taken_jobs_.Contains(job_id)) {
     return JobState::kTaken;
   } else {
     return JobState::kNotAssigned;
@@ -137,37 +166,95 @@ JobState AssignmentsState::KnownJobState(Id<Job> job_id) {
 }
 
 bool AssignmentsState::TryAssign(Id<Machine> machine_id, Job job) {
+  LSS_STATS_ADD(StatCounter::kAssignmentsAttempted, 1);
   if (writer_->Assign(static_cast<IdType>(machine_id), static_cast<IdType>(job.id()))) {
-    machines_assignments_.insert(std::make_pair(machine_id, job.id()));
-    jobs_assignments_.insert(std::make_pair(job.id(), machine_id));
-    machines_next_contexts_[machine_id] = job.context();
+    KnownMachine &machine = machines_[machine_id];
+    machine.job = job.id();
+    machine.has_next_context = true;
+    machine.next_context = job.context();
+    pending_jobs_[job.id()] = machine_id;
     return true;
   }
+  LSS_STATS_ADD(StatCounter::kAssignmentsFailed, 1);
   return false;
 }
 
 bool AssignmentsState::HasTakenAJob(Id<Machine> machine_id) {
-  auto machine_assignment = machines_assignments_.find(machine_id);
-  Id<Job> job_id = machine_assignment->second;
+  KnownMachine *machine = machines_.Find(machine_id);
+  return machine && machine->job && HasTakenAJob(machine_id, machine);
+}
+
+bool AssignmentsState::HasTakenAJob(Id<Machine> machine_id, KnownMachine *machine) {
+  Id<Job> job_id = machine->job;
   if (!writer_->DoesAssignmentExist(static_cast<IdType>(machine_id))) {
-    machines_assignments_.erase(machine_id);
-    jobs_assignments_.erase(job_id);
-    taken_jobs_.insert(job_id);
-    SwitchContext(machine_id);
+    machine->job = Id<Job>();
+    pending_jobs_.Erase(job_id);
+    taken_jobs_.Insert(job_id);
+    SwitchContext(machine);
     return true;
   }
   return false;
 }
 
 void AssignmentsState::SwitchContext(Id<Machine> machine_id) {
-  auto machine_next_context = machines_next_contexts_.find(machine_id);
-  machines_contexts_[machine_id] = machine_next_context->second;
-  machines_next_contexts_.erase(machine_next_context);
+  if (KnownMachine *machine = machines_.Find(machine_id)) {
+    SwitchContext(machine);
+  }
+}
+
+void AssignmentsState::SwitchContext(KnownMachine *machine) {
+  if (machine->has_next_context) {
+    machine->has_context = true;
+    machine->context = machine->next_context;
+    machine->has_next_context = false;
+  }
 }
 
 Context AssignmentsState::GetMachineContext(Id<Machine> machine_id) const {
-  auto context = machines_contexts_.find(machine_id);
-  return context == machines_contexts_.end() ? Context() : context->second;
+  const KnownMachine *machine = machines_.Find(machine_id);
+  return machine && machine->has_context ? machine->context : Context();
+}
+
+AssignmentsSnapshot AssignmentsState::Snapshot() const {
+  AssignmentsSnapshot snapshot;
+  machines_.ForEachUnordered([&snapshot](Id<Machine> machine_id, const KnownMachine &machine) {
+    if (machine.job) {
+      snapshot.assignments.emplace_back(machine_id, machine.job);
+    }
+    if (machine.has_context) {
+      snapshot.contexts.emplace_back(machine_id, machine.context);
+    }
+    if (machine.has_next_context) {
+      snapshot.next_contexts.emplace_back(machine_id, machine.next_context);
+    }
+  });
+  taken_jobs_.ForEachUnordered([&snapshot](Id<Job> job_id) {
+    snapshot.taken_jobs.push_back(job_id);
+  });
+  return snapshot;
+}
+
+void AssignmentsState::Restore(const AssignmentsSnapshot &snapshot) {
+  machines_.Clear();
+  pending_jobs_.Clear();
+  taken_jobs_.Clear();
+  for (const auto &assignment : snapshot.assignments) {
+    machines_[assignment.first].job = assignment.second;
+    pending_jobs_[assignment.second] = assignment.first;
+  }
+  for (const auto &context : snapshot.contexts) {
+    KnownMachine &machine = machines_[context.first];
+    machine.has_context = true;
+    machine.context = context.second;
+  }
+  for (const auto &next_context : snapshot.next_contexts) {
+    KnownMachine &machine = machines_[next_context.first];
+    machine.has_next_context = true;
+    machine.next_context = next_context.second;
+  }
+  for (Id<Job> job_id : snapshot.taken_jobs) {
+    taken_jobs_.Insert(job_id);
+  }
 }
 
 }  // namespace io
@@ -1,7 +1,11 @@
 #ifndef LSS_IO_ASSIGNMENT_HANDLER_H_
 #define LSS_IO_ASSIGNMENT_HANDLER_H_
 
+#include <utility>
+#include <vector>
+
 #include "base/schedule.h"
+#include "base/sorted_id_map.h"
 #include "io/basic_output.h"
 
 namespace lss {
@@ -13,17 +17,24 @@ enum class JobState {
   kTaken = 2
 };
 
+// Plain copy of AssignmentsState, e.g. for checkpoints.
+struct AssignmentsSnapshot {
+  std::vector<std::pair<Id<Machine>, Id<Job>>> assignments;  // Pending ones.
+  std::vector<Id<Job>> taken_jobs;
+  std::vector<std::pair<Id<Machine>, Context>> contexts, next_contexts;
+};
+
+// Ids are kept in SortedIdMaps rather than hash tables, so that the state is swept together
+// with a situation sorted by ids in linear time and without allocations.
 class AssignmentsState {
  public:
-  using JobsAssignments = std::unordered_map<Id<Job>, Id<Machine>>;
-  using MachinesAssignments = std::unordered_map<Id<Machine>, Id<Job>>;
-  using MachinesContexts = std::unordered_map<Id<Machine>, Context>;
-
   explicit AssignmentsState(Writer *writer) : writer_(writer) { }
 
   void UpdateTakenJobs();
+  // The following methods expect records of `raw_situation` sorted by ids.
   void RemoveNotPresentMachines(const RawSituation &raw_situation);
   void RemoveNotPresentJobs(const RawSituation &raw_situation);
+  void RemoveTakenJobs(RawSituation *raw_situation);
   bool TryAssign(Id<Machine> machine_id, Job job);
   bool TryUnassign(Id<Machine> machine_id);
   Id<Machine> GetAssignedMachineId(Id<Job> job_id);
@@ -31,13 +42,30 @@ class AssignmentsState {
   bool HasTakenAJob(Id<Machine> machine_id);
   void SwitchContext(Id<Machine> machine_id);
   Context GetMachineContext(Id<Machine> machine_id) const;
+  AssignmentsSnapshot Snapshot() const;
+  // Replaces the whole state, e.g. after a restart. Restored pending assignments are checked
+  // by the next UpdateTakenJobs() like any others.
+  void Restore(const AssignmentsSnapshot &snapshot);
 
  private:
+  // State of a machine which has a pending assignment or a known context.
+  struct KnownMachine {
+    Id<Job> job;  // The pending assignment, if any.
+    bool has_context = false, has_next_context = false;
+    Context context, next_context;  // The latter is the context of the pending job.
+
+    bool empty() const { return !job && !has_context && !has_next_context; }
+  };
+
+  // These do not access machines_, so they can be called while it is swept.
+  bool TryUnassign(Id<Machine> machine_id, KnownMachine *machine);
+  bool HasTakenAJob(Id<Machine> machine_id, KnownMachine *machine);
+  static void SwitchContext(KnownMachine *machine);
+
   Writer *writer_;
-  JobsAssignments jobs_assignments_;
-  MachinesAssignments machines_assignments_;
-  std::unordered_set<Id<Job>> taken_jobs_;
-  MachinesContexts machines_contexts_, machines_next_contexts_;
+  SortedIdMap<Id<Machine>, KnownMachine> machines_;
+  SortedIdMap<Id<Job>, Id<Machine>> pending_jobs_;
+  SortedIdSet<Id<Job>> taken_jobs_;
 };
 
 class AssignmentsHandler {
@@ -45,12 +73,18 @@ class AssignmentsHandler {
   explicit AssignmentsHandler(Writer *writer) : assignments_state_(writer) { }
 
   void AdjustRawSituation(RawSituation *raw_situation);
+  // Assigns the first job of every queue which can still be assigned to its machine.
+  // Pending assignments which stay the same are not issued again, so the method can be
+  // called repeatedly with improving schedules of a single situation.
   void AdjustAssignments(const Schedule &schedule);
+  AssignmentsSnapshot Snapshot() const { return assignments_state_.Snapshot(); }
+  void Restore(const AssignmentsSnapshot &snapshot) { assignments_state_.Restore(snapshot); }
 
  private:
-  void RemoveAlreadyTakenJobs(RawSituation *raw_situation);
   void FillMachineContexts(RawSituation *raw_situation);
-  Job FindJobToAssign(const Schedule::Jobs &jobs);
+  // Returns whether the first job of `jobs` which is not taken is pending on `machine`.
+  bool IsAlreadyAssigned(Machine machine, Schedule::JobSpan jobs);
+  Job FindJobToAssign(Schedule::JobSpan jobs);
   bool CanBeAssigned(Job job);
 
   AssignmentsState assignments_state_;
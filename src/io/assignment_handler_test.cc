@@ -1,5 +1,6 @@
 #include "io/assignment_handler.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -12,6 +13,7 @@ namespace io {
 
 using ::testing::Test;
 using ::testing::Return;
+using ::testing::_;
 
 Schedule BuildSchedule(const std::vector<std::vector<int>> &assignments, Situation situation) {
   Schedule schedule(situation);
@@ -53,11 +55,12 @@ TEST_F(AssignmentsHandlerShould, unasign_job_from_previous_machine_if_not_taken)
   Schedule old_schedule = BuildSchedule({{0}, {1}, {2}}, situation_);
   Schedule new_schedule = BuildSchedule({{2}, {1}, {0}}, situation_);
 
+  // The pending assignment of job 1 is kept.
   EXPECT_CALL(writer_, Assign(0, 0)).WillOnce(Return(true));
-  EXPECT_CALL(writer_, Assign(1, 1)).Times(2).WillRepeatedly(Return(true));
+  EXPECT_CALL(writer_, Assign(1, 1)).WillOnce(Return(true));
   EXPECT_CALL(writer_, Assign(2, 2)).WillOnce(Return(true));
   EXPECT_CALL(writer_, Unassign(0)).WillOnce(Return(true));
-  EXPECT_CALL(writer_, Unassign(1)).WillOnce(Return(true));
+  EXPECT_CALL(writer_, Unassign(1)).Times(0);
   EXPECT_CALL(writer_, Unassign(2)).WillOnce(Return(true));
 
   EXPECT_CALL(writer_, Assign(0, 2));
@@ -77,7 +80,8 @@ TEST_F(AssignmentsHandlerShould, not_unasign_job_from_previous_machine_if_taken)
   EXPECT_CALL(writer_, Assign(2, 2)).WillOnce(Return(true));
   EXPECT_CALL(writer_, Unassign(0)).WillOnce(Return(true));
   EXPECT_CALL(writer_, Unassign(1)).WillOnce(Return(false));
-  EXPECT_CALL(writer_, Unassign(2)).WillOnce(Return(false));
+  // Job 2 stays on machine 2, so its assignment is kept whether it was taken or not.
+  EXPECT_CALL(writer_, Unassign(2)).Times(0);
 
   EXPECT_CALL(writer_, Assign(0, 3));
   EXPECT_CALL(writer_, Assign(1, 0));
@@ -121,5 +125,44 @@ TEST_F(AssignmentsHandlerShould, fill_machine_context) {
   EXPECT_EQ(Context(), raw_situation.machines_[2].context_);
 }
 
+TEST_F(AssignmentsHandlerShould, sort_and_remove_taken_jobs) {
+  Schedule schedule = BuildSchedule({{3}, {1}, {}}, situation_);
+  EXPECT_CALL(writer_, Assign(0, 3)).WillOnce(Return(true));
+  EXPECT_CALL(writer_, Assign(1, 1)).WillOnce(Return(true));
+  EXPECT_CALL(writer_, DoesAssignmentExist(0)).WillRepeatedly(Return(false));
+  EXPECT_CALL(writer_, DoesAssignmentExist(1)).WillRepeatedly(Return(true));
+
+  AssignmentsHandler assignments_handler(&writer_);
+  assignments_handler.AdjustAssignments(schedule);
+  std::reverse(raw_situation_.jobs_.begin(), raw_situation_.jobs_.end());
+  assignments_handler.AdjustRawSituation(&raw_situation_);
+
+  std::vector<IdType> job_ids;
+  for (const RawJob &raw_job : raw_situation_.jobs_) job_ids.push_back(raw_job.id_);
+  EXPECT_EQ(std::vector<IdType>({0, 1, 2}), job_ids);
+
+  // The taken job is forgotten once it is not in the input.
+  assignments_handler.AdjustRawSituation(&raw_situation_);
+  EXPECT_TRUE(assignments_handler.Snapshot().taken_jobs.empty());
+}
+
+TEST_F(AssignmentsHandlerShould, unassign_job_from_removed_machine) {
+  Schedule schedule = BuildSchedule({{0}, {1}, {2}}, situation_);
+  EXPECT_CALL(writer_, Assign(0, 0)).WillOnce(Return(true));
+  EXPECT_CALL(writer_, Assign(1, 1)).WillOnce(Return(true));
+  EXPECT_CALL(writer_, Assign(2, 2)).WillOnce(Return(true));
+  EXPECT_CALL(writer_, DoesAssignmentExist(_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(writer_, Unassign(1)).WillOnce(Return(true));
+
+  AssignmentsHandler assignments_handler(&writer_);
+  assignments_handler.AdjustAssignments(schedule);
+  raw_situation_.machines_.erase(raw_situation_.machines_.begin() + 1);
+  assignments_handler.AdjustRawSituation(&raw_situation_);
+
+  AssignmentsSnapshot snapshot = assignments_handler.Snapshot();
+  EXPECT_EQ(2, snapshot.assignments.size());
+  EXPECT_EQ(4, raw_situation_.jobs_.size());
+}
+
 }  // namespace io
 }  // namespace lss
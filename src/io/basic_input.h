@@ -1,11 +1,18 @@
 #ifndef LSS_IO_BASIC_INPUT_H_
 #define LSS_IO_BASIC_INPUT_H_
 
+#include <array>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "glog/logging.h"
+
 #include "base/raw_situation.h"
 #include "io/reader.h"
 
@@ -19,8 +26,8 @@ class BasicReader: public Reader {
 
   void SetInputPath(const std::string &input_path) override;
 
-  // The contents of the files are not validated and reading malformed
-  // records will quietly result in corrupted data.
+  // Replaces the records of `destination`. The contents of the files are not validated
+  // and reading malformed records will quietly result in corrupted data.
   bool Read(RawSituation* destination) override;
 
  private:
@@ -35,6 +42,77 @@ std::istream &operator>>(std::istream &input, ::lss::RawFairSet &set);
 std::istream &operator>>(std::istream &input, ::lss::RawAccount &account);
 std::istream &operator>>(std::istream &input, ::lss::RawChangeCost &change);
 
+// Sections of the basic input format are read to a sink, which gets every record with
+// `sink->add(record)` - like RawSituation - so that other formats built on it
+// (see DeltaReader) share the parsing.
+template<class Sink>
+using SectionReader = void (*)(std::istream*, Sink*);
+
+template<class Sink>
+using HeaderReaderPair = std::tuple<const char*, SectionReader<Sink>>;
+
+template<class T, class Sink>
+void ReadOne(std::istream* input, Sink* sink) {
+  T record;
+  *input >> record;
+  sink->add(std::move(record));
+}
+
+template<class Sink>
+constexpr std::array<HeaderReaderPair<Sink>, 7> kReaders{
+  HeaderReaderPair<Sink>{"machines", &ReadOne<RawMachine, Sink>},
+  HeaderReaderPair<Sink>{"machine-sets", &ReadOne<RawMachineSet, Sink>},
+  HeaderReaderPair<Sink>{"fair-service-machine-sets", &ReadOne<RawFairSet, Sink>},
+  HeaderReaderPair<Sink>{"jobs", &ReadOne<RawJob, Sink>},
+  HeaderReaderPair<Sink>{"batches", &ReadOne<RawBatch, Sink>},
+  HeaderReaderPair<Sink>{"accounts", &ReadOne<RawAccount, Sink>},
+  HeaderReaderPair<Sink>{"context-changes", &ReadOne<RawChangeCost, Sink>},
+};
+
+// Returns nullptr if `header` is not a header of `readers`.
+template<class Sink, size_t N>
+SectionReader<Sink> FindSectionReader(const std::array<HeaderReaderPair<Sink>, N> &readers,
+                                      const std::string &header) {
+  for (size_t i = 0; i < readers.size(); ++i) {
+    if (header == std::get<0>(readers[i]))
+      return std::get<1>(readers[i]);
+  }
+  return nullptr;
+}
+
+// Returns nullptr if `header` is not a header of the basic input format.
+template<class Sink>
+SectionReader<Sink> GetSectionReader(const std::string &header) {
+  return FindSectionReader(kReaders<Sink>, header);
+}
+
+// Reads lines of `input` until its end. A line for which `get_reader` returns a reader
+// is a header of a section and the following lines are passed to that reader.
+template<class Sink>
+void ReadSections(std::istream* input, SectionReader<Sink> (*get_reader)(const std::string &),
+                  Sink* sink) {
+  SectionReader<Sink> reader = nullptr;
+  std::string line;
+  while (getline(*input, line)) {
+    if (line.empty())
+      continue;
+
+    if (SectionReader<Sink> new_reader = get_reader(line)) {
+      reader = new_reader;
+    } else if (reader) {
+      std::istringstream line_stream(line);
+      reader(&line_stream, sink);
+    } else {
+      LOG(WARNING) << "Expected header in input line: '" << line;
+    }
+  }
+}
+
+// Renames the file at `input_path`, so that the driver can write the next one, passes it
+// to `read` and removes it. Returns false if there is no file or `read` returns false.
+bool ReadInputFile(const std::string &input_path,
+                   const std::function<bool(std::istream*)> &read);
+
 }  // namespace io
 }  // namespace lss
 
@@ -6,6 +6,8 @@
 
 #include <iostream>
 
+#include "base/stats.h"
+
 namespace lss {
 namespace io {
 
@@ -27,6 +29,7 @@ bool BasicWriter::Assign(IdType machine_id, IdType job_id) {
   // This functions as a lock and makes Assign() safe for concurrent calls.
   // Creates file with READ and WRITE permissions for the user.
   int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  LSS_STATS_ADD(StatCounter::kSyscalls, 1);
   if (fd == -1) {
     PLOG(WARNING) << "Creating temporary file failed";
     return false;
@@ -36,6 +39,7 @@ bool BasicWriter::Assign(IdType machine_id, IdType job_id) {
   // assignment) - call to access() might fail for other reasons than
   // nonexistence of the file.
   bool ok = (access(path.c_str(), F_OK) == -1);
+  LSS_STATS_ADD(StatCounter::kSyscalls, 1);
   PLOG_IF(WARNING, !ok) << "There is a pending assignment";
 
   if (ok) {
@@ -43,9 +47,11 @@ bool BasicWriter::Assign(IdType machine_id, IdType job_id) {
     PLOG_IF(WARNING, !ok) << "Write failed";
     ok &= (close(fd) != -1);
     PLOG_IF(WARNING, !ok) << "Close failed";
+    LSS_STATS_ADD(StatCounter::kSyscalls, 2);
   }
   if (ok) {
     ok &= (rename(tmp_path.c_str(), path.c_str()) != -1);
+    LSS_STATS_ADD(StatCounter::kSyscalls, 1);
     PLOG_IF(WARNING, !ok) << "Rename failed";
   }
   if (ok) {
@@ -55,6 +61,7 @@ bool BasicWriter::Assign(IdType machine_id, IdType job_id) {
 
   remove(tmp_path.c_str());
   PLOG_IF(WARNING, remove(tmp_path.c_str())) << "Remove temporary file failed";
+  LSS_STATS_ADD(StatCounter::kSyscalls, 2);
   return false;
 }
 
@@ -62,6 +69,7 @@ bool BasicWriter::Unassign(IdType machine_id) {
   const std::string path = output_path_ + std::to_string(machine_id);
   int result;
   PLOG_IF(INFO, result = remove(path.c_str())) << "Unassign failed";
+  LSS_STATS_ADD(StatCounter::kSyscalls, 1);
   if (result == 0) {
     VLOG(2) << "Job unassigned from machine: " << machine_id;
     return true;
@@ -73,9 +81,11 @@ bool BasicWriter::DoesAssignmentExist(IdType machine_id) {
   const std::string path = output_path_ + std::to_string(machine_id);
   int fd = open(path.c_str(), O_RDONLY, S_IRUSR);
   if (fd == -1) {
+    LSS_STATS_ADD(StatCounter::kSyscalls, 1);
     return false;
   }
   PLOG_IF(WARNING, close(fd) == -1) << "Close failed";
+  LSS_STATS_ADD(StatCounter::kSyscalls, 2);
   return true;
 }
 
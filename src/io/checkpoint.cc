@@ -0,0 +1,282 @@
+#include "io/checkpoint.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+
+namespace lss {
+namespace io {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x4353534c;  // "LSSC" in little endian.
+constexpr uint32_t kVersion = 2;
+
+// FNV-1a, like checksums of journal records.
+uint32_t Checksum(const char *data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Values are stored in the native byte order, checkpoints are read on the same host.
+class Encoder {
+ public:
+  template<class T>
+  void Put(T value) { data_.append(reinterpret_cast<const char *>(&value), sizeof(value)); }
+
+  template<class T>
+  void Put(Id<T> id) { Put(static_cast<IdType>(id)); }
+
+  void Put(const Context &context) {
+    for (int i = 0; i < Context::kSize; ++i)
+      Put(context[i]);
+  }
+
+  template<class T, class U>
+  void Put(const std::pair<T, U> &pair) {
+    Put(pair.first);
+    Put(pair.second);
+  }
+
+  template<class T>
+  void Put(const std::vector<T> &values) {
+    Put(static_cast<uint64_t>(values.size()));
+    for (const T &value : values)
+      Put(value);
+  }
+
+  std::string data() && { return std::move(data_); }
+
+ private:
+  std::string data_;
+};
+
+// Every Get() returns false once the first `size` bytes of the data are exhausted.
+class Decoder {
+ public:
+  Decoder(const std::string &data, size_t size) : data_(data), size_(size) {}
+
+  template<class T>
+  bool Get(T *value) {
+    if (size_ - offset_ < sizeof(T)) return false;
+    std::memcpy(value, data_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  template<class T>
+  bool Get(Id<T> *id) {
+    IdType value;
+    if (!Get(&value)) return false;
+    *id = Id<T>(value);
+    return true;
+  }
+
+  bool Get(Context *context) {
+    for (int i = 0; i < Context::kSize; ++i) {
+      if (!Get(&(*context)[i])) return false;
+    }
+    return true;
+  }
+
+  template<class T, class U>
+  bool Get(std::pair<T, U> *pair) { return Get(&pair->first) && Get(&pair->second); }
+
+  template<class T>
+  bool Get(std::vector<T> *values) {
+    uint64_t size;
+    // Every element takes at least a byte, so a corrupted size cannot allocate too much.
+    if (!Get(&size) || size > size_ - offset_) return false;
+    values->resize(size);
+    for (T &value : *values) {
+      if (!Get(&value)) return false;
+    }
+    return true;
+  }
+
+  bool Done() const { return offset_ == size_; }
+
+ private:
+  const std::string &data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+}  // namespace
+
+Checkpoint::Queues QueuesOf(const Schedule &schedule) {
+  Checkpoint::Queues queues(schedule.queue_count());
+  for (size_t queue = 0; queue < schedule.queue_count(); ++queue) {
+    queues[queue].first = static_cast<IdType>(schedule.machine(queue).id());
+    for (Job job : schedule.jobs(queue))
+      queues[queue].second.push_back(static_cast<IdType>(job.id()));
+  }
+  return queues;
+}
+
+Schedule RestoreSchedule(const Checkpoint::Queues &queues, Situation situation) {
+  Schedule schedule(situation);
+  for (const auto &queue : queues) {
+    Machine machine = situation[Id<Machine>(queue.first)];
+    if (!machine || !machine.alive()) continue;
+    for (IdType job_id : queue.second) {
+      Job job = situation[Id<Job>(job_id)];
+      if (job && job.machine_set().contains(machine))
+        schedule.AssignJob(machine, job);
+    }
+  }
+  return schedule;
+}
+
+std::string EncodeCheckpoint(const Checkpoint &checkpoint) {
+  Encoder encoder;
+  encoder.Put(kMagic);
+  encoder.Put(kVersion);
+  encoder.Put(checkpoint.assignments.assignments);
+  encoder.Put(checkpoint.assignments.taken_jobs);
+  encoder.Put(checkpoint.assignments.contexts);
+  encoder.Put(checkpoint.assignments.next_contexts);
+  encoder.Put(checkpoint.schedule);
+  std::string data = std::move(encoder).data();
+  uint32_t checksum = Checksum(data.data(), data.size());
+  data.append(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+  return data;
+}
+
+bool DecodeCheckpoint(const std::string &data, Checkpoint *checkpoint) {
+  // The checksum of the preceding bytes is stored at the end.
+  uint32_t checksum;
+  if (data.size() < sizeof(checksum)) return false;
+  size_t size = data.size() - sizeof(checksum);
+  std::memcpy(&checksum, data.data() + size, sizeof(checksum));
+  if (checksum != Checksum(data.data(), size)) return false;
+
+  Decoder decoder(data, size);
+  uint32_t magic, version;
+  return decoder.Get(&magic) && magic == kMagic
+      && decoder.Get(&version) && version == kVersion
+      && decoder.Get(&checkpoint->assignments.assignments)
+      && decoder.Get(&checkpoint->assignments.taken_jobs)
+      && decoder.Get(&checkpoint->assignments.contexts)
+      && decoder.Get(&checkpoint->assignments.next_contexts)
+      && decoder.Get(&checkpoint->schedule)
+      && decoder.Done();
+}
+
+bool ReadCheckpoint(const std::string &path, Checkpoint *checkpoint) {
+  std::ifstream input(path, std::ios::binary);
+  if (!input) return false;
+  std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+  if (!DecodeCheckpoint(data, checkpoint)) {
+    LOG(WARNING) << "Invalid checkpoint " << path;
+    *checkpoint = Checkpoint();
+    return false;
+  }
+  return true;
+}
+
+CheckpointWriter::CheckpointWriter(const std::string &path, std::chrono::seconds interval)
+    : path_(path), interval_(interval), last_checkpoint_(std::chrono::steady_clock::now()),
+      thread_(&CheckpointWriter::Loop, this) {}
+
+CheckpointWriter::~CheckpointWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  pending_or_stop_.notify_one();
+  thread_.join();
+}
+
+void CheckpointWriter::Tick(const AssignmentsHandler &assignments_handler,
+                            const Schedule &schedule) {
+  auto now = std::chrono::steady_clock::now();
+  if (now - last_checkpoint_ < interval_)
+    return;
+  last_checkpoint_ = now;
+  Write({assignments_handler.Snapshot(), QueuesOf(schedule)});
+}
+
+void CheckpointWriter::Write(Checkpoint checkpoint) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = std::move(checkpoint);
+    has_pending_ = true;
+  }
+  pending_or_stop_.notify_one();
+}
+
+void CheckpointWriter::Loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    pending_or_stop_.wait(lock, [this]() { return has_pending_ || stop_; });
+    if (has_pending_) {
+      Checkpoint checkpoint = std::move(pending_);
+      has_pending_ = false;
+      lock.unlock();
+      WriteFile(checkpoint);
+      lock.lock();
+    } else {
+      return;
+    }
+  }
+}
+
+void CheckpointWriter::WriteFile(const Checkpoint &checkpoint) {
+  const std::string tmp_path = path_ + "_tmp";
+  std::string data = EncodeCheckpoint(checkpoint);
+
+  // The data is synced before the rename and the directory after it, so that the checkpoint
+  // at `path_` is complete even if the machine crashes, not only the scheduler.
+  int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd == -1) {
+    PLOG(WARNING) << "Creating checkpoint " << tmp_path << " failed";
+    return;
+  }
+  bool ok = true;
+  for (size_t written = 0; ok && written < data.size();) {
+    ssize_t result = write(fd, data.data() + written, data.size() - written);
+    ok = result != -1 || errno == EINTR;
+    if (result > 0) written += result;
+  }
+  PLOG_IF(WARNING, !ok) << "Writing checkpoint " << tmp_path << " failed";
+  ok = ok && fsync(fd) != -1;
+  PLOG_IF(WARNING, !ok) << "Syncing checkpoint " << tmp_path << " failed";
+  if (close(fd) == -1) {
+    PLOG_IF(WARNING, ok) << "Closing checkpoint " << tmp_path << " failed";
+    ok = false;
+  }
+  if (ok && std::rename(tmp_path.c_str(), path_.c_str()) == -1) {
+    PLOG(WARNING) << "Renaming checkpoint " << tmp_path << " failed";
+    ok = false;
+  }
+  if (!ok) {
+    std::remove(tmp_path.c_str());
+    return;
+  }
+
+  size_t slash = path_.rfind('/');
+  const std::string directory = slash == std::string::npos ? "." : path_.substr(0, slash + 1);
+  int dir_fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  PLOG_IF(WARNING, dir_fd == -1 || fsync(dir_fd) == -1)
+      << "Syncing checkpoint directory " << directory << " failed";
+  if (dir_fd != -1) close(dir_fd);
+}
+
+}  // namespace io
+}  // namespace lss
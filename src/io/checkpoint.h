@@ -0,0 +1,87 @@
+// This header provides checkpoints of the scheduler - the state of assignments and the last
+// schedule - which let a restarted scheduler continue where the previous one stopped
+// instead of starting with empty contexts and forgotten assignments.
+
+#ifndef LSS_IO_CHECKPOINT_H_
+#define LSS_IO_CHECKPOINT_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "base/schedule.h"
+#include "base/situation.h"
+#include "io/assignment_handler.h"
+
+namespace lss {
+namespace io {
+
+struct Checkpoint {
+  // Machine id and ids of its jobs. The schedule is stored by ids, since the situation
+  // it was built for is not a part of the checkpoint.
+  using Queues = std::vector<std::pair<IdType, std::vector<IdType>>>;
+
+  AssignmentsSnapshot assignments;
+  Queues schedule;
+};
+
+Checkpoint::Queues QueuesOf(const Schedule &schedule);
+
+// Rebuilds a schedule saved with QueuesOf() for `situation`. Machines which are missing
+// or dead and jobs which are missing or cannot run on their machine are skipped.
+Schedule RestoreSchedule(const Checkpoint::Queues &queues, Situation situation);
+
+// Compact binary encoding with a format version and a checksum, so that checkpoints of
+// other versions or corrupted ones are rejected instead of misread.
+std::string EncodeCheckpoint(const Checkpoint &checkpoint);
+
+// Returns false if `data` is not a valid checkpoint.
+bool DecodeCheckpoint(const std::string &data, Checkpoint *checkpoint);
+
+// Returns false if there is no valid checkpoint at `path`.
+bool ReadCheckpoint(const std::string &path, Checkpoint *checkpoint);
+
+// Writes checkpoints to `path` on a background thread, so that encoding and file system
+// calls stay off the scheduling loop. A checkpoint is first written to a temporary file and
+// synced, then renamed, so that a crash never leaves a partial one behind. If the thread is
+// busy, only the newest of the checkpoints passed in the meantime is written.
+class CheckpointWriter {
+ public:
+  CheckpointWriter(const std::string &path, std::chrono::seconds interval);
+
+  // Writes the pending checkpoint, if any, before returning.
+  ~CheckpointWriter();
+
+  CheckpointWriter(const CheckpointWriter &) = delete;
+  CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+  // Passes the state of `assignments_handler` and `schedule` to Write() if at least
+  // `interval` passed since the last checkpoint.
+  void Tick(const AssignmentsHandler &assignments_handler, const Schedule &schedule);
+
+  void Write(Checkpoint checkpoint);
+
+ private:
+  void Loop();
+  void WriteFile(const Checkpoint &checkpoint);
+
+  const std::string path_;
+  const std::chrono::seconds interval_;
+  std::chrono::steady_clock::time_point last_checkpoint_;
+
+  std::mutex mutex_;
+  std::condition_variable pending_or_stop_;
+  Checkpoint pending_;
+  bool has_pending_ = false;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace io
+}  // namespace lss
+
+#endif  // LSS_IO_CHECKPOINT_H_
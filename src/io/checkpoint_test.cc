@@ -0,0 +1,149 @@
+#include "io/checkpoint.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "genetic/test_utils.h"
+
+namespace lss {
+namespace io {
+namespace {
+
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::UnorderedElementsAre;
+using ::testing::_;
+
+Checkpoint Sample() {
+  Checkpoint checkpoint;
+  checkpoint.assignments.assignments = {{Id<Machine>(1), Id<Job>(2)}};
+  checkpoint.assignments.taken_jobs = {Id<Job>(3), Id<Job>(4)};
+  checkpoint.assignments.contexts = {{Id<Machine>(0), Context(1, 2, 3)}};
+  checkpoint.assignments.next_contexts = {{Id<Machine>(1), Context(4, 5, 6)}};
+  checkpoint.schedule = {{0, {0, 1}}, {2, {}}};
+  return checkpoint;
+}
+
+void ExpectEqual(const Checkpoint &expected, const Checkpoint &actual) {
+  EXPECT_EQ(expected.assignments.assignments, actual.assignments.assignments);
+  EXPECT_EQ(expected.assignments.taken_jobs, actual.assignments.taken_jobs);
+  EXPECT_EQ(expected.assignments.contexts, actual.assignments.contexts);
+  EXPECT_EQ(expected.assignments.next_contexts, actual.assignments.next_contexts);
+  EXPECT_EQ(expected.schedule, actual.schedule);
+}
+
+TEST(CheckpointTest, EncodingRoundTrips) {
+  Checkpoint decoded;
+  ASSERT_TRUE(DecodeCheckpoint(EncodeCheckpoint(Sample()), &decoded));
+  ExpectEqual(Sample(), decoded);
+}
+
+TEST(CheckpointTest, RejectsInvalidData) {
+  std::string data = EncodeCheckpoint(Sample());
+  Checkpoint decoded;
+  EXPECT_FALSE(DecodeCheckpoint("", &decoded));
+  EXPECT_FALSE(DecodeCheckpoint(data.substr(0, data.size() - 1), &decoded));
+  EXPECT_FALSE(DecodeCheckpoint(data + '\0', &decoded));
+  std::string other_version = data;
+  other_version[4] ^= 1;
+  EXPECT_FALSE(DecodeCheckpoint(other_version, &decoded));
+}
+
+TEST(CheckpointTest, RejectsCorruptedData) {
+  const std::string data = EncodeCheckpoint(Sample());
+  Checkpoint decoded;
+  for (size_t i = 0; i < data.size(); ++i) {
+    std::string corrupted = data;
+    corrupted[i] ^= 0x10;
+    EXPECT_FALSE(DecodeCheckpoint(corrupted, &decoded)) << "byte " << i;
+  }
+}
+
+TEST(CheckpointTest, RestoresScheduleInNewSituation) {
+  Situation old_situation(genetic::GetSimpleRawSituation(4, 3));
+  Schedule schedule(old_situation);
+  schedule.AssignJob(old_situation[Id<Machine>(0)], old_situation[Id<Job>(3)]);
+  schedule.AssignJob(old_situation[Id<Machine>(0)], old_situation[Id<Job>(1)]);
+  schedule.AssignJob(old_situation[Id<Machine>(2)], old_situation[Id<Job>(2)]);
+
+  // Machine 2 and job 3 are gone.
+  Situation situation(genetic::GetSimpleRawSituation(3, 2));
+  Schedule restored = RestoreSchedule(QueuesOf(schedule), situation);
+
+  ASSERT_EQ(2u, restored.queue_count());
+  ASSERT_EQ(1u, restored.jobs(situation[Id<Machine>(0)]).size());
+  EXPECT_EQ(Id<Job>(1), restored.jobs(situation[Id<Machine>(0)])[0].id());
+  EXPECT_TRUE(restored.jobs(situation[Id<Machine>(1)]).empty());
+}
+
+TEST(CheckpointTest, RestoresAssignmentsState) {
+  RawSituation raw = genetic::GetSimpleRawSituation(4, 3);
+  raw.jobs_[0].context(Context(1, 2, 3));
+  Situation situation(raw);
+  Schedule schedule(situation);
+  schedule.AssignJob(situation[Id<Machine>(0)], situation[Id<Job>(0)]);
+
+  NiceMock<WriterMock> writer;
+  ON_CALL(writer, Assign(_, _)).WillByDefault(Return(true));
+  AssignmentsHandler old_handler(&writer);
+  old_handler.AdjustAssignments(schedule);
+
+  Checkpoint decoded;
+  ASSERT_TRUE(DecodeCheckpoint(EncodeCheckpoint({old_handler.Snapshot(), {}}), &decoded));
+  AssignmentsHandler handler(&writer);
+  handler.Restore(decoded.assignments);
+
+  // The restored assignment is not issued again and its context is used once it is taken.
+  EXPECT_CALL(writer, Assign(_, _)).Times(0);
+  handler.AdjustAssignments(schedule);
+  EXPECT_CALL(writer, DoesAssignmentExist(0)).WillOnce(Return(false));
+  handler.AdjustRawSituation(&raw);
+  EXPECT_EQ(Context(1, 2, 3), raw.machines_[0].context_);
+  EXPECT_THAT(handler.Snapshot().taken_jobs, UnorderedElementsAre(Id<Job>(0)));
+}
+
+TEST(CheckpointTest, WriterWritesLatestCheckpoint) {
+  const std::string path = ::testing::TempDir() + "checkpoint_test";
+  std::remove(path.c_str());
+  {
+    CheckpointWriter writer(path, std::chrono::seconds(0));
+    writer.Write(Checkpoint());
+    writer.Write(Sample());
+  }
+  Checkpoint read;
+  ASSERT_TRUE(ReadCheckpoint(path, &read));
+  ExpectEqual(Sample(), read);
+  std::remove(path.c_str());
+}
+
+TEST(CheckpointTest, ReadFailsForCorruptedFile) {
+  const std::string path = ::testing::TempDir() + "corrupted_checkpoint_test";
+  std::remove(path.c_str());
+  {
+    CheckpointWriter writer(path, std::chrono::seconds(0));
+    writer.Write(Sample());
+  }
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(12);
+    file.put('\x7f');
+  }
+  Checkpoint read;
+  EXPECT_FALSE(ReadCheckpoint(path, &read));
+  ExpectEqual(Checkpoint(), read);
+  std::remove(path.c_str());
+}
+
+TEST(CheckpointTest, ReadFailsWithoutFile) {
+  Checkpoint read;
+  EXPECT_FALSE(ReadCheckpoint(::testing::TempDir() + "missing_checkpoint", &read));
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace lss
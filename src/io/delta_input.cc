@@ -0,0 +1,225 @@
+#include "io/delta_input.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+
+#include "io/basic_input.h"
+
+namespace lss {
+namespace io {
+namespace {
+
+template<class T>
+IdType KeyOf(const T &record) { return record.id_; }
+
+// There are only as many change costs as changes, so changes are their ids.
+IdType KeyOf(const RawChangeCost &change_cost) {
+  return static_cast<IdType>(static_cast<size_t>(change_cost.change_));
+}
+
+template<class T>
+typename std::vector<T>::iterator LowerBound(std::vector<T> *records, IdType key) {
+  return std::lower_bound(records->begin(), records->end(), key,
+                          [](const T &record, IdType key) { return KeyOf(record) < key; });
+}
+
+// Passes records of the sections to the live situation.
+class LiveSink {
+ public:
+  explicit LiveSink(LiveSituation *live) : live_(live) {}
+
+  template<class T>
+  void add(const T &record) { live_->Upsert(record); }
+
+  template<class T>
+  void Remove(IdType id) { live_->Remove<T>(id); }
+
+ private:
+  LiveSituation *live_;
+};
+
+template<class T>
+void RemoveAll(std::istream* input, LiveSink* sink) {
+  IdType id;
+  while (*input >> id) {
+    sink->Remove<T>(id);
+  }
+}
+
+constexpr std::array<HeaderReaderPair<LiveSink>, 6> kRemovedReaders{
+  HeaderReaderPair<LiveSink>{"removed-machines", &RemoveAll<RawMachine>},
+  HeaderReaderPair<LiveSink>{"removed-machine-sets", &RemoveAll<RawMachineSet>},
+  HeaderReaderPair<LiveSink>{"removed-fair-service-machine-sets", &RemoveAll<RawFairSet>},
+  HeaderReaderPair<LiveSink>{"removed-jobs", &RemoveAll<RawJob>},
+  HeaderReaderPair<LiveSink>{"removed-batches", &RemoveAll<RawBatch>},
+  HeaderReaderPair<LiveSink>{"removed-accounts", &RemoveAll<RawAccount>},
+};
+
+SectionReader<LiveSink> GetDeltaSectionReader(const std::string &header) {
+  if (SectionReader<LiveSink> reader = FindSectionReader(kRemovedReaders, header))
+    return reader;
+  return GetSectionReader<LiveSink>(header);
+}
+
+}  // namespace
+
+template<> std::vector<RawMachine> &LiveSituation::Records() { return raw_.machines_; }
+template<> std::vector<RawMachineSet> &LiveSituation::Records() { return raw_.machine_sets_; }
+template<> std::vector<RawFairSet> &LiveSituation::Records() { return raw_.fair_sets_; }
+template<> std::vector<RawJob> &LiveSituation::Records() { return raw_.jobs_; }
+template<> std::vector<RawBatch> &LiveSituation::Records() { return raw_.batches_; }
+template<> std::vector<RawAccount> &LiveSituation::Records() { return raw_.accounts_; }
+template<> std::vector<RawChangeCost> &LiveSituation::Records() { return raw_.change_costs_; }
+
+template<> LiveSituation::Section &LiveSituation::SectionOf<RawMachine>() { return machines_; }
+template<> LiveSituation::Section &LiveSituation::SectionOf<RawMachineSet>() {
+  return machine_sets_;
+}
+template<> LiveSituation::Section &LiveSituation::SectionOf<RawFairSet>() { return fair_sets_; }
+template<> LiveSituation::Section &LiveSituation::SectionOf<RawJob>() { return jobs_; }
+template<> LiveSituation::Section &LiveSituation::SectionOf<RawBatch>() { return batches_; }
+template<> LiveSituation::Section &LiveSituation::SectionOf<RawAccount>() { return accounts_; }
+template<> LiveSituation::Section &LiveSituation::SectionOf<RawChangeCost>() {
+  return change_costs_;
+}
+
+void LiveSituation::Clear() {
+  raw_ = RawSituation();
+  for (Section *section : {&machines_, &machine_sets_, &fair_sets_, &jobs_, &batches_,
+                           &accounts_, &change_costs_}) {
+    *section = Section();
+  }
+}
+
+template<class T>
+void LiveSituation::Upsert(const T &record) {
+  std::vector<T> &records = Records<T>();
+  Section &section = SectionOf<T>();
+  section.changed = true;
+  IdType key = KeyOf(record);
+  // New records usually have the highest ids.
+  if (records.empty() || KeyOf(records.back()) < key) {
+    records.push_back(record);
+    return;
+  }
+  auto it = LowerBound(&records, key);
+  if (it != records.end() && KeyOf(*it) == key) {
+    *it = record;
+    section.removed.erase(key);
+  } else {
+    records.insert(it, record);
+  }
+}
+
+template<class T>
+void LiveSituation::Remove(IdType id) {
+  std::vector<T> &records = Records<T>();
+  auto it = LowerBound(&records, id);
+  if (it == records.end() || KeyOf(*it) != id)
+    return;
+  Section &section = SectionOf<T>();
+  section.removed.insert(id);
+  section.changed = true;
+}
+
+template<class T>
+void LiveSituation::CommitSection() {
+  Section &section = SectionOf<T>();
+  if (section.removed.empty())
+    return;
+  std::vector<T> &records = Records<T>();
+  records.erase(std::remove_if(records.begin(), records.end(), [&section](const T &record) {
+                  return section.removed.count(KeyOf(record)) > 0;
+                }),
+                records.end());
+  section.removed.clear();
+}
+
+void LiveSituation::Commit() {
+  CommitSection<RawMachine>();
+  CommitSection<RawMachineSet>();
+  CommitSection<RawFairSet>();
+  CommitSection<RawJob>();
+  CommitSection<RawBatch>();
+  CommitSection<RawAccount>();
+  CommitSection<RawChangeCost>();
+}
+
+template<class T>
+void LiveSituation::CopySection(std::vector<T> *destination) {
+  Section &section = SectionOf<T>();
+  DCHECK(section.removed.empty()) << "CopyTo() called before Commit()";
+  if (section.changed || destination->size() != Records<T>().size())
+    *destination = Records<T>();
+  section.changed = false;
+}
+
+void LiveSituation::CopyTo(RawSituation *destination) {
+  destination->time_stamp_ = raw_.time_stamp_;
+  CopySection(&destination->machines_);
+  CopySection(&destination->machine_sets_);
+  CopySection(&destination->fair_sets_);
+  CopySection(&destination->jobs_);
+  CopySection(&destination->batches_);
+  CopySection(&destination->accounts_);
+  CopySection(&destination->change_costs_);
+}
+
+template void LiveSituation::Upsert(const RawMachine &);
+template void LiveSituation::Upsert(const RawMachineSet &);
+template void LiveSituation::Upsert(const RawFairSet &);
+template void LiveSituation::Upsert(const RawJob &);
+template void LiveSituation::Upsert(const RawBatch &);
+template void LiveSituation::Upsert(const RawAccount &);
+template void LiveSituation::Upsert(const RawChangeCost &);
+template void LiveSituation::Remove<RawMachine>(IdType);
+template void LiveSituation::Remove<RawMachineSet>(IdType);
+template void LiveSituation::Remove<RawFairSet>(IdType);
+template void LiveSituation::Remove<RawJob>(IdType);
+template void LiveSituation::Remove<RawBatch>(IdType);
+template void LiveSituation::Remove<RawAccount>(IdType);
+
+bool DeltaReader::Read(RawSituation* destination) {
+  return ReadInputFile(input_path_, [this, destination](std::istream* input) {
+    if (!Apply(input))
+      return false;
+    live_.CopyTo(destination);
+    return true;
+  });
+}
+
+bool DeltaReader::Apply(std::istream* input) {
+  std::string line;
+  getline(*input, line);
+  std::istringstream first_line(line);
+  std::string kind;
+  int64_t number;
+  if (!(first_line >> kind >> number) || (kind != "snapshot" && kind != "delta")) {
+    LOG(WARNING) << "Expected snapshot or delta in input line: '" << line;
+    synchronized_ = false;
+    return false;
+  }
+  if (kind == "snapshot") {
+    live_.Clear();
+  } else if (!synchronized_ || number != last_number_ + 1) {
+    if (synchronized_) {
+      LOG(WARNING) << "Input delta " << number << " does not follow " << last_number_
+                   << ", waiting for snapshot";
+    }
+    synchronized_ = false;
+    return false;
+  }
+  synchronized_ = true;
+  last_number_ = number;
+
+  LiveSink sink(&live_);
+  ReadSections(input, &GetDeltaSectionReader, &sink);
+  live_.Commit();
+  return true;
+}
+
+}  // namespace io
+}  // namespace lss
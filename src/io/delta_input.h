@@ -0,0 +1,96 @@
+#ifndef LSS_IO_DELTA_INPUT_H_
+#define LSS_IO_DELTA_INPUT_H_
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/raw_situation.h"
+#include "io/reader.h"
+
+namespace lss {
+namespace io {
+
+// Situation kept up to date with changes of its records. Records of every section are
+// kept sorted by ids (change costs by their changes), so they are found by binary search
+// and the situation stays sorted, as AssignmentsHandler needs it. Removals are applied by
+// Commit() in a single pass over each section, so that removing many records does not
+// move the others many times.
+class LiveSituation {
+ public:
+  // Includes records removed since the last Commit().
+  const RawSituation &raw() const { return raw_; }
+
+  void Clear();
+
+  // Adds a record or replaces the one with the same id.
+  template<class T>
+  void Upsert(const T &record);
+
+  // Does nothing if there is no record with `id`.
+  template<class T>
+  void Remove(IdType id);
+
+  void Commit();
+
+  // Copies the records to `destination`, which should hold the records of the previous
+  // CopyTo(), possibly with some of them removed. Sections which did not change since
+  // then are not copied again, unless `destination` has a different number of records in
+  // them (e.g. if it is new). Must not be called before Commit().
+  void CopyTo(RawSituation *destination);
+
+ private:
+  struct Section {
+    std::unordered_set<IdType> removed;  // Ids of records to remove at Commit().
+    bool changed = true;  // Since the last CopyTo().
+  };
+
+  template<class T> std::vector<T> &Records();
+  template<class T> Section &SectionOf();
+  template<class T> void CommitSection();
+  template<class T> void CopySection(std::vector<T> *destination);
+
+  RawSituation raw_;
+  Section machines_, machine_sets_, fair_sets_, jobs_, batches_, accounts_, change_costs_;
+};
+
+// Reads the delta input format. It is the basic input format (see BasicReader) preceded
+// by a line "snapshot <number>" or "delta <number>", where numbers of consecutive files
+// are consecutive. A snapshot contains the whole situation. A delta contains records
+// which were added or updated since the previous file in the usual sections and ids of
+// removed records in sections named "removed-<section>" (e.g. "removed-jobs"); change costs
+// are never removed. So the driver can write only what changed, and the reader parses
+// only that and applies it to the live situation.
+//
+// A delta which does not follow the previous file is skipped with all deltas up to
+// the next snapshot, so a driver should write a snapshot instead of replacing a file
+// which was not read yet, and periodically anyway.
+class DeltaReader : public Reader {
+ public:
+  // 'input_path' should name a file (not directory) with input data.
+  explicit DeltaReader(const std::string &input_path) : input_path_(input_path) {}
+
+  void SetInputPath(const std::string &input_path) override { input_path_ = input_path; }
+
+  // Copies the live situation to `destination` after applying the file, see
+  // LiveSituation::CopyTo(). So `destination` should be kept between calls and only its
+  // machine contexts changed or records removed, as AssignmentsHandler does. Returns false
+  // if there is no file or it is a skipped delta.
+  bool Read(RawSituation *destination) override;
+
+  // Applies the file read from `input`; exposed for testing.
+  bool Apply(std::istream *input);
+
+ private:
+  std::string input_path_;
+  LiveSituation live_;
+  bool synchronized_ = false;  // Whether the live situation follows the last read file.
+  int64_t last_number_ = 0;
+};
+
+}  // namespace io
+}  // namespace lss
+
+#endif  // LSS_IO_DELTA_INPUT_H_
@@ -0,0 +1,135 @@
+#include "io/delta_input.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace lss {
+namespace io {
+namespace {
+
+bool Apply(DeltaReader *reader, const std::string &data) {
+  std::istringstream input(data);
+  return reader->Apply(&input);
+}
+
+std::vector<IdType> JobIds(const RawSituation &raw) {
+  std::vector<IdType> ids;
+  for (const RawJob &job : raw.jobs_) ids.push_back(job.id_);
+  return ids;
+}
+
+TEST(LiveSituationTest, UpsertsAndRemovesRecords) {
+  LiveSituation live;
+  live.Upsert(RawJob().id(3));
+  live.Upsert(RawJob().id(1));
+  live.Upsert(RawJob().id(2));
+  live.Upsert(RawJob().id(1).duration(5));
+  EXPECT_EQ(std::vector<IdType>({1, 2, 3}), JobIds(live.raw()));
+  EXPECT_EQ(5, live.raw().jobs_[0].duration_);
+
+  live.Remove<RawJob>(1);
+  live.Remove<RawJob>(7);
+  live.Remove<RawJob>(3);
+  live.Upsert(RawJob().id(3).duration(2));
+  live.Commit();
+  EXPECT_EQ(std::vector<IdType>({2, 3}), JobIds(live.raw()));
+  EXPECT_EQ(2, live.raw().jobs_[1].duration_);
+  live.Remove<RawJob>(2);
+  live.Remove<RawJob>(3);
+  live.Commit();
+  EXPECT_TRUE(live.raw().jobs_.empty());
+}
+
+TEST(LiveSituationTest, CopiesOnlyChangedSections) {
+  LiveSituation live;
+  live.Upsert(RawJob().id(1));
+  live.Upsert(RawJob().id(2));
+  live.Upsert(RawMachine().id(1));
+  live.Commit();
+  RawSituation raw;
+  live.CopyTo(&raw);
+  EXPECT_EQ(std::vector<IdType>({1, 2}), JobIds(raw));
+  ASSERT_EQ(1, raw.machines_.size());
+
+  // Unchanged sections are not copied again, unless records were removed from them.
+  raw.machines_[0].context(Context(1, 2, 3));
+  raw.jobs_.pop_back();
+  live.CopyTo(&raw);
+  EXPECT_EQ(Context(1, 2, 3), raw.machines_[0].context_);
+  EXPECT_EQ(std::vector<IdType>({1, 2}), JobIds(raw));
+
+  live.Upsert(RawMachine().id(1));
+  live.CopyTo(&raw);
+  EXPECT_EQ(Context(), raw.machines_[0].context_);
+
+  RawSituation new_raw;
+  live.CopyTo(&new_raw);
+  EXPECT_EQ(std::vector<IdType>({1, 2}), JobIds(new_raw));
+  EXPECT_EQ(1, new_raw.machines_.size());
+}
+
+TEST(LiveSituationTest, KeysChangeCostsByChanges) {
+  LiveSituation live;
+  live.Upsert(RawChangeCost().change(Change(1, 0, 0)).cost(1));
+  live.Upsert(RawChangeCost().change(Change(0, 1, 0)).cost(2));
+  live.Upsert(RawChangeCost().change(Change(1, 0, 0)).cost(3));
+  ASSERT_EQ(2, live.raw().change_costs_.size());
+  EXPECT_EQ(3, live.raw().change_costs_[0].cost_);
+}
+
+void WriteInput(const std::string &path, const std::string &data) {
+  std::ofstream(path) << data;
+}
+
+TEST(DeltaReaderTest, AppliesDeltasToSnapshot) {
+  const std::string path = ::testing::TempDir() + "delta_input_test";
+  DeltaReader reader(path);
+  RawSituation raw;
+  EXPECT_FALSE(reader.Read(&raw));
+
+  WriteInput(path,
+             "snapshot 4\n"
+             "machines\n1 1\n2 1\n"
+             "machine-sets\n1 1 2\n"
+             "jobs\n1 1 10 1 0 0 0\n2 1 20 1 0 0 0\n"
+             "context-changes\n1 0 0 5\n");
+  ASSERT_TRUE(reader.Read(&raw));
+  EXPECT_EQ(std::vector<IdType>({1, 2}), JobIds(raw));
+  EXPECT_EQ(2, raw.machines_.size());
+  EXPECT_FALSE(reader.Read(&raw));
+
+  WriteInput(path,
+             "delta 5\n"
+             "removed-jobs\n1\n"
+             "jobs\n3 1 30 1 0 0 0\n2 1 25 1 0 0 0\n"
+             "removed-machines\n2\n"
+             "machine-sets\n1 1\n");
+  raw = RawSituation();
+  ASSERT_TRUE(reader.Read(&raw));
+  EXPECT_EQ(std::vector<IdType>({2, 3}), JobIds(raw));
+  EXPECT_EQ(25, raw.jobs_[0].duration_);
+  ASSERT_EQ(1, raw.machines_.size());
+  EXPECT_EQ(1, raw.machines_[0].id_);
+  ASSERT_EQ(1, raw.machine_sets_.size());
+  EXPECT_EQ(std::vector<IdType>({1}), raw.machine_sets_[0].machines_);
+  ASSERT_EQ(1, raw.change_costs_.size());
+  EXPECT_EQ(5, raw.change_costs_[0].cost_);
+}
+
+TEST(DeltaReaderTest, SkipsDeltasUntilSnapshot) {
+  DeltaReader reader("");
+  EXPECT_FALSE(Apply(&reader, "delta 1\njobs\n1 1 10 1 0 0 0\n"));
+  ASSERT_TRUE(Apply(&reader, "snapshot 1\n"));
+  EXPECT_FALSE(Apply(&reader, "delta 3\n"));
+  EXPECT_FALSE(Apply(&reader, "delta 2\n"));
+  EXPECT_FALSE(Apply(&reader, "jobs\n"));
+  EXPECT_TRUE(Apply(&reader, "snapshot 7\n"));
+  EXPECT_TRUE(Apply(&reader, "delta 8\n"));
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace lss
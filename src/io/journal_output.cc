@@ -0,0 +1,225 @@
+#include "io/journal_output.h"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace lss {
+namespace io {
+
+namespace {
+
+void ThrowErrno(const std::string &what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+void Fnv1a(const void *data, size_t size, uint32_t *hash) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    *hash ^= bytes[i];
+    *hash *= 16777619u;
+  }
+}
+
+size_t JournalSize(size_t capacity) {
+  return kJournalRecordsOffset + capacity * sizeof(JournalRecord);
+}
+
+}  // namespace
+
+constexpr uint32_t JournalHeader::kMagic;
+constexpr uint32_t JournalHeader::kVersion;
+constexpr size_t JournalWriter::kDefaultCapacity;
+constexpr std::chrono::milliseconds JournalWriter::kDefaultTakeTimeout;
+
+uint32_t JournalChecksum(const JournalRecord &record) {
+  uint32_t hash = 2166136261u;
+  Fnv1a(&record.sequence, sizeof(record.sequence), &hash);
+  Fnv1a(&record.type, sizeof(record.type), &hash);
+  Fnv1a(&record.machine_id, sizeof(record.machine_id), &hash);
+  Fnv1a(&record.job_id, sizeof(record.job_id), &hash);
+  return hash;
+}
+
+JournalFile::JournalFile(const std::string &path, bool create, size_t capacity) {
+  int fd = open(path.c_str(), O_RDWR | (create ? O_CREAT : 0), S_IRUSR | S_IWUSR);
+  if (fd == -1) ThrowErrno("Opening journal " + path + " failed");
+  struct stat stat;
+  if (fstat(fd, &stat) == -1) {
+    close(fd);
+    ThrowErrno("Reading size of journal " + path + " failed");
+  }
+
+  // The header is read with pread(), so that the file is mapped only once.
+  JournalHeader header{};
+  bool valid = pread(fd, &header, sizeof(header), 0) == sizeof(header)
+      && header.magic == JournalHeader::kMagic && header.version == JournalHeader::kVersion
+      && header.capacity > 0 && static_cast<size_t>(stat.st_size) >= JournalSize(header.capacity);
+  if (create && (!valid || header.capacity != capacity)) {
+    LOG(INFO) << "Creating journal " << path << " of " << capacity << " records";
+    header = JournalHeader{JournalHeader::kMagic, JournalHeader::kVersion, capacity, 0};
+    // Truncating to zero first clears records of the previous journal.
+    if (ftruncate(fd, 0) == -1 || ftruncate(fd, JournalSize(capacity)) == -1
+        || pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+      close(fd);
+      ThrowErrno("Creating journal " + path + " failed");
+    }
+  } else if (!valid) {
+    close(fd);
+    throw std::runtime_error("Invalid journal " + path);
+  }
+
+  size_ = JournalSize(header.capacity);
+  void *data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) ThrowErrno("Mapping journal " + path + " failed");
+  header_ = static_cast<JournalHeader *>(data);
+  records_ = reinterpret_cast<JournalRecord *>(static_cast<char *>(data) + kJournalRecordsOffset);
+}
+
+JournalFile::~JournalFile() {
+  PLOG_IF(WARNING, munmap(header_, size_) == -1) << "Unmapping journal failed";
+}
+
+JournalWriter::JournalWriter(const std::string &path, size_t capacity,
+                             std::chrono::milliseconds take_timeout)
+    : file_(path, true, capacity), take_timeout_(take_timeout) {
+  // Assignments which are neither taken nor cancelled are still pending.
+  uint64_t head = file_.header()->head;
+  uint64_t first = head > capacity ? head - capacity + 1 : 1;
+  for (uint64_t sequence = first; sequence <= head; ++sequence) {
+    const JournalRecord *record = file_.record(sequence);
+    if (record->sequence != sequence || record->checksum != JournalChecksum(*record)) continue;
+    if (record->type == JournalRecord::kAssign && !record->cancelled
+        && record->take != JournalRecord::kTaken) {
+      pending_[record->machine_id] = sequence;
+    }
+  }
+  LOG(INFO) << "Journal " << path << " continues after record " << head << " with "
+            << pending_.size() << " pending assignments";
+}
+
+JournalRecord *JournalWriter::Append(JournalRecord::Type type, IdType machine_id,
+                                     IdType job_id) {
+  JournalHeader *header = file_.header();
+  uint64_t sequence = header->head + 1;
+  JournalRecord *record = file_.record(sequence);
+  if (sequence > header->capacity && record->type == JournalRecord::kAssign) {
+    auto pending = pending_.find(record->machine_id);
+    if (pending != pending_.end() && pending->second == record->sequence
+        && Pending(record->machine_id)) {
+      return nullptr;
+    }
+  }
+
+  record->sequence = sequence;
+  record->type = type;
+  record->machine_id = machine_id;
+  record->job_id = job_id;
+  record->take = JournalRecord::kNotTaken;
+  record->cancelled = 0;
+  record->checksum = JournalChecksum(*record);
+  __atomic_store_n(&header->head, sequence, __ATOMIC_RELEASE);
+  return record;
+}
+
+JournalRecord *JournalWriter::Pending(IdType machine_id) {
+  auto pending = pending_.find(machine_id);
+  if (pending == pending_.end()) return nullptr;
+  JournalRecord *record = file_.record(pending->second);
+  if (__atomic_load_n(&record->take, __ATOMIC_ACQUIRE) == JournalRecord::kTaken) {
+    pending_.erase(pending);
+    return nullptr;
+  }
+  return record;
+}
+
+bool JournalWriter::Assign(IdType machine_id, IdType job_id) {
+  if (Pending(machine_id)) {
+    LOG(WARNING) << "There is a pending assignment";
+    return false;
+  }
+  JournalRecord *record = Append(JournalRecord::kAssign, machine_id, job_id);
+  if (!record) {
+    LOG(WARNING) << "Journal is full of pending assignments";
+    return false;
+  }
+  pending_[machine_id] = record->sequence;
+  return true;
+}
+
+bool JournalWriter::Unassign(IdType machine_id) {
+  JournalRecord *record = Pending(machine_id);
+  if (!record) return false;
+  pending_.erase(machine_id);
+
+  __atomic_store_n(&record->cancelled, 1, __ATOMIC_SEQ_CST);
+  uint32_t take;
+  auto deadline = std::chrono::steady_clock::now() + take_timeout_;
+  while ((take = __atomic_load_n(&record->take, __ATOMIC_SEQ_CST)) == JournalRecord::kTaking) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      LOG(WARNING) << "Driver is taking the job of machine: " << machine_id << " for over "
+                   << take_timeout_.count() << "ms, considering it taken";
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  if (take == JournalRecord::kTaken) {
+    LOG(INFO) << "Unassign failed, machine: " << machine_id << " has taken the job";
+    return false;
+  }
+  // The cancelled assignment is enough for drivers, so a full ring only loses the record.
+  LOG_IF(WARNING, !Append(JournalRecord::kUnassign, machine_id, record->job_id))
+      << "Journal is full of pending assignments";
+  return true;
+}
+
+bool JournalWriter::DoesAssignmentExist(IdType machine_id) {
+  return Pending(machine_id) != nullptr;
+}
+
+bool JournalReader::Next(JournalRecord *record) {
+  const JournalHeader *header = file_.header();
+  while (true) {
+    uint64_t head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+    if (next_ > head) return false;
+    if (head - next_ >= header->capacity) {
+      LOG(WARNING) << "Journal reader lost records " << next_ << "-" << head - header->capacity;
+      next_ = head - header->capacity + 1;
+    }
+    std::memcpy(record, file_.record(next_), sizeof(*record));
+    // The record might have been overwritten while it was copied.
+    head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+    if (head - next_ >= header->capacity) continue;
+    if (record->sequence == next_ && record->checksum == JournalChecksum(*record)) {
+      ++next_;
+      return true;
+    }
+    LOG(WARNING) << "Journal reader skipped invalid record " << next_++;
+  }
+}
+
+bool JournalReader::TryTake(uint64_t sequence) {
+  JournalRecord *record = file_.record(sequence);
+  if (__atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != sequence
+      || __atomic_load_n(&record->cancelled, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+  __atomic_store_n(&record->take, JournalRecord::kTaking, __ATOMIC_SEQ_CST);
+  bool cancelled = __atomic_load_n(&record->cancelled, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&record->take, cancelled ? JournalRecord::kBackedOff : JournalRecord::kTaken,
+                   __ATOMIC_RELEASE);
+  return !cancelled;
+}
+
+}  // namespace io
+}  // namespace lss
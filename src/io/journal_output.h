@@ -0,0 +1,142 @@
+// This header provides JournalWriter - a Writer which appends assignments to a single
+// memory mapped journal instead of creating a file per assignment, and JournalReader -
+// its counterpart for drivers (system_tests/internals/assignments.py is another one).
+//
+// The journal is a file with a header followed by a ring buffer of fixed size records,
+// numbered with consecutive sequence numbers from 1. The writer fills a record, including
+// its checksum, and then publishes it by storing its sequence number as the head of the
+// journal. Readers tail the journal by sequence numbers; checksums let them detect records
+// overwritten while they were read, which happens only if they fall behind by the whole ring.
+//
+// Whether an assignment is still pending is decided by two fields of its record, each
+// written by one side only: `take` by the driver and `cancelled` by the scheduler.
+// A driver takes a job by storing kTaking, then loading `cancelled`, and then storing
+// kTaken, or kBackedOff if the assignment was cancelled. The scheduler cancels by storing
+// `cancelled` and then loading `take`, waiting while it is kTaking. Stores are followed by
+// full fences, so at least one side sees the store of the other one and exactly one of
+// them wins - like rename() and remove() of the assignment file of BasicWriter. A driver
+// which dies between its stores leaves kTaking behind, so the scheduler waits for a bounded
+// time and then considers the job taken.
+
+#ifndef LSS_IO_JOURNAL_OUTPUT_H_
+#define LSS_IO_JOURNAL_OUTPUT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "io/basic_output.h"
+
+namespace lss {
+namespace io {
+
+struct JournalHeader {
+  static constexpr uint32_t kMagic = 0x4e4a534c;  // "LSJN" in little endian.
+  static constexpr uint32_t kVersion = 1;
+
+  uint32_t magic;
+  uint32_t version;
+  uint64_t capacity;  // Number of records in the ring.
+  uint64_t head;      // Sequence number of the last published record, 0 if there are none.
+};
+
+struct JournalRecord {
+  enum Type : uint32_t { kAssign = 1, kUnassign = 2 };
+  enum Take : uint32_t { kNotTaken = 0, kTaking = 1, kTaken = 2, kBackedOff = 3 };
+
+  uint64_t sequence;
+  uint32_t type;
+  uint32_t checksum;  // Of the fields above and the ids.
+  int64_t machine_id;
+  int64_t job_id;     // Only in assignments.
+  uint32_t take;      // Written only by the driver.
+  uint32_t cancelled;  // Written only by the scheduler.
+};
+
+static_assert(sizeof(JournalHeader) == 24, "Journal layout is shared with drivers");
+static_assert(sizeof(JournalRecord) == 40, "Journal layout is shared with drivers");
+
+// Records start at this offset of the journal file.
+static constexpr size_t kJournalRecordsOffset = 64;
+
+uint32_t JournalChecksum(const JournalRecord &record);
+
+// Maps the journal at `path`, e.g. for JournalWriter and JournalReader, and unmaps it
+// on destruction. If `create` is true, a missing or invalid journal (or one of another
+// capacity) is replaced with an empty one of `capacity` records.
+class JournalFile {
+ public:
+  JournalFile(const std::string &path, bool create, size_t capacity = 0);
+  ~JournalFile();
+
+  JournalFile(const JournalFile &) = delete;
+  JournalFile &operator=(const JournalFile &) = delete;
+
+  JournalHeader *header() const { return header_; }
+  JournalRecord *record(uint64_t sequence) const {
+    return records_ + (sequence - 1) % header_->capacity;
+  }
+
+ private:
+  size_t size_ = 0;
+  JournalHeader *header_ = nullptr;
+  JournalRecord *records_ = nullptr;
+};
+
+class JournalWriter : public Writer {
+ public:
+  static constexpr size_t kDefaultCapacity = 1 << 16;
+  static constexpr std::chrono::milliseconds kDefaultTakeTimeout{100};
+
+  // Continues the journal at `path` if it is valid, so that assignments which are still
+  // pending after a restart are known. Throws std::runtime_error if it cannot be mapped.
+  // Unassign() waits at most `take_timeout` for a driver which is taking the job.
+  explicit JournalWriter(const std::string &path, size_t capacity = kDefaultCapacity,
+                         std::chrono::milliseconds take_timeout = kDefaultTakeTimeout);
+
+  // Fails if there is a pending assignment or if the ring is full, i.e. the oldest record
+  // is a pending assignment.
+  bool Assign(IdType machine_id, IdType job_id) override;
+
+  // Fails if there is no pending assignment or the driver has taken the job, or has been
+  // taking it for longer than `take_timeout`.
+  bool Unassign(IdType machine_id) override;
+
+  bool DoesAssignmentExist(IdType machine_id) override;
+
+ private:
+  // Returns nullptr if the ring is full.
+  JournalRecord *Append(JournalRecord::Type type, IdType machine_id, IdType job_id);
+  // Returns the pending assignment of `machine_id` and forgets it if it was taken.
+  JournalRecord *Pending(IdType machine_id);
+
+  JournalFile file_;
+  const std::chrono::milliseconds take_timeout_;
+  // Sequence numbers of pending assignments.
+  std::unordered_map<IdType, uint64_t> pending_;
+};
+
+// Reads the journal at `path` from its first record which was not overwritten yet.
+class JournalReader {
+ public:
+  explicit JournalReader(const std::string &path) : file_(path, false) {}
+
+  // Copies the next published record to `record`. Returns false if there is none or
+  // the reader fell behind by the whole ring, in which case it skips the lost records.
+  bool Next(JournalRecord *record);
+
+  // Takes the job of the assignment with `sequence`. Returns false if the assignment was
+  // cancelled or overwritten.
+  bool TryTake(uint64_t sequence);
+
+ private:
+  JournalFile file_;
+  uint64_t next_ = 1;
+};
+
+}  // namespace io
+}  // namespace lss
+
+#endif  // LSS_IO_JOURNAL_OUTPUT_H_
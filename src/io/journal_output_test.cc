@@ -0,0 +1,142 @@
+#include "io/journal_output.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace lss {
+namespace io {
+namespace {
+
+class JournalTest : public ::testing::Test {
+ protected:
+  void SetUp() override { std::remove(path_.c_str()); }
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  const std::string path_ = ::testing::TempDir() + "journal_test";
+};
+
+TEST_F(JournalTest, ReaderTailsAssignments) {
+  JournalWriter writer(path_, 16);
+  JournalReader reader(path_);
+  JournalRecord record;
+  EXPECT_FALSE(reader.Next(&record));
+
+  EXPECT_TRUE(writer.Assign(1, 10));
+  EXPECT_TRUE(writer.Assign(2, 20));
+  EXPECT_TRUE(writer.Unassign(1));
+
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(1u, record.sequence);
+  EXPECT_EQ(JournalRecord::kAssign, record.type);
+  EXPECT_EQ(1, record.machine_id);
+  EXPECT_EQ(10, record.job_id);
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(2, record.machine_id);
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(3u, record.sequence);
+  EXPECT_EQ(JournalRecord::kUnassign, record.type);
+  EXPECT_EQ(1, record.machine_id);
+  EXPECT_FALSE(reader.Next(&record));
+}
+
+TEST_F(JournalTest, AssignmentIsPendingUntilTaken) {
+  JournalWriter writer(path_, 16);
+  JournalReader reader(path_);
+  EXPECT_FALSE(writer.DoesAssignmentExist(1));
+  EXPECT_TRUE(writer.Assign(1, 10));
+  EXPECT_TRUE(writer.DoesAssignmentExist(1));
+  EXPECT_FALSE(writer.Assign(1, 11));
+
+  EXPECT_TRUE(reader.TryTake(1));
+  EXPECT_FALSE(writer.DoesAssignmentExist(1));
+  EXPECT_FALSE(writer.Unassign(1));
+  EXPECT_TRUE(writer.Assign(1, 11));
+}
+
+TEST_F(JournalTest, CancelledAssignmentCannotBeTaken) {
+  JournalWriter writer(path_, 16);
+  JournalReader reader(path_);
+  EXPECT_TRUE(writer.Assign(1, 10));
+  EXPECT_TRUE(writer.Unassign(1));
+  EXPECT_FALSE(writer.DoesAssignmentExist(1));
+  EXPECT_FALSE(reader.TryTake(1));
+  EXPECT_FALSE(writer.Unassign(1));
+}
+
+TEST_F(JournalTest, TakenAssignmentCannotBeUnassigned) {
+  JournalWriter writer(path_, 16);
+  JournalReader reader(path_);
+  EXPECT_TRUE(writer.Assign(1, 10));
+  EXPECT_TRUE(reader.TryTake(1));
+  EXPECT_FALSE(writer.Unassign(1));
+}
+
+TEST_F(JournalTest, AssignmentBeingTakenTooLongIsConsideredTaken) {
+  JournalWriter writer(path_, 16, std::chrono::milliseconds(10));
+  EXPECT_TRUE(writer.Assign(1, 10));
+  // A driver which died after storing kTaking.
+  JournalFile file(path_, false);
+  file.record(1)->take = JournalRecord::kTaking;
+
+  EXPECT_FALSE(writer.Unassign(1));
+  EXPECT_FALSE(writer.DoesAssignmentExist(1));
+  EXPECT_EQ(1u, file.header()->head);
+}
+
+TEST_F(JournalTest, FullRingKeepsPendingAssignments) {
+  JournalWriter writer(path_, 2);
+  JournalReader reader(path_);
+  EXPECT_TRUE(writer.Assign(1, 10));
+  EXPECT_TRUE(writer.Assign(2, 20));
+  EXPECT_FALSE(writer.Assign(3, 30));
+
+  EXPECT_TRUE(reader.TryTake(1));
+  EXPECT_TRUE(writer.Assign(3, 30));
+  EXPECT_TRUE(writer.DoesAssignmentExist(2));
+}
+
+TEST_F(JournalTest, ReaderSkipsOverwrittenRecords) {
+  JournalWriter writer(path_, 2);
+  JournalReader reader(path_);
+  for (int machine = 0; machine < 5; ++machine) {
+    EXPECT_TRUE(writer.Assign(machine, machine));
+    EXPECT_TRUE(writer.Unassign(machine));
+  }
+  JournalRecord record;
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(9u, record.sequence);
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(10u, record.sequence);
+  EXPECT_FALSE(reader.Next(&record));
+}
+
+TEST_F(JournalTest, WriterContinuesJournalAfterRestart) {
+  {
+    JournalWriter writer(path_, 16);
+    EXPECT_TRUE(writer.Assign(1, 10));
+    EXPECT_TRUE(writer.Assign(2, 20));
+    JournalReader reader(path_);
+    EXPECT_TRUE(reader.TryTake(1));
+  }
+  JournalWriter writer(path_, 16);
+  EXPECT_FALSE(writer.DoesAssignmentExist(1));
+  EXPECT_TRUE(writer.DoesAssignmentExist(2));
+  EXPECT_TRUE(writer.Assign(3, 30));
+
+  JournalReader reader(path_);
+  JournalRecord record;
+  for (int i = 0; i < 3; ++i)
+    ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(3, record.machine_id);
+}
+
+TEST_F(JournalTest, ReaderRejectsMissingJournal) {
+  EXPECT_THROW(JournalReader reader(path_), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace lss
@@ -0,0 +1,243 @@
+#include "io/shm_transport.h"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "base/stats.h"
+
+namespace lss {
+namespace io {
+
+namespace {
+
+void ThrowErrno(const std::string &what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Records without vectors are copied as they are, situations are read on the same host.
+template<class T>
+void PutRecords(const std::vector<T> &records, std::string *data) {
+  static_assert(std::is_trivially_copyable<T>::value, "Records are copied bytewise");
+  uint64_t count = records.size();
+  data->append(reinterpret_cast<const char *>(&count), sizeof(count));
+  data->append(reinterpret_cast<const char *>(records.data()), count * sizeof(T));
+}
+
+// Machine sets and fair sets.
+template<class T>
+void PutSets(const std::vector<T> &sets, std::string *data) {
+  uint64_t count = sets.size();
+  data->append(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (const T &set : sets) {
+    data->append(reinterpret_cast<const char *>(&set.id_), sizeof(set.id_));
+    PutRecords(set.machines_, data);
+  }
+}
+
+class Cursor {
+ public:
+  Cursor(const char *data, size_t size) : data_(data), size_(size) {}
+
+  bool Get(void *destination, size_t size) {
+    if (size_ - offset_ < size) return false;
+    std::memcpy(destination, data_ + offset_, size);
+    offset_ += size;
+    return true;
+  }
+
+  template<class T>
+  bool GetRecords(std::vector<T> *records) {
+    uint64_t count;
+    if (!Get(&count, sizeof(count)) || count > (size_ - offset_) / sizeof(T)) return false;
+    records->resize(count);
+    return Get(records->data(), count * sizeof(T));
+  }
+
+  template<class T>
+  bool GetSets(std::vector<T> *sets) {
+    uint64_t count;
+    if (!Get(&count, sizeof(count)) || count > (size_ - offset_) / sizeof(IdType)) return false;
+    sets->resize(count);
+    for (T &set : *sets) {
+      if (!Get(&set.id_, sizeof(set.id_)) || !GetRecords(&set.machines_)) return false;
+    }
+    return true;
+  }
+
+  bool Done() const { return offset_ == size_; }
+
+ private:
+  const char *data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+}  // namespace
+
+constexpr uint32_t ShmHeader::kMagic;
+constexpr uint32_t ShmHeader::kVersion;
+constexpr size_t ShmSituationPublisher::kDefaultBufferCapacity;
+
+std::string EncodeRawSituation(const RawSituation &raw) {
+  std::string data;
+  data.append(reinterpret_cast<const char *>(&raw.time_stamp_), sizeof(raw.time_stamp_));
+  PutRecords(raw.machines_, &data);
+  PutSets(raw.machine_sets_, &data);
+  PutSets(raw.fair_sets_, &data);
+  PutRecords(raw.jobs_, &data);
+  PutRecords(raw.batches_, &data);
+  PutRecords(raw.accounts_, &data);
+  PutRecords(raw.change_costs_, &data);
+  return data;
+}
+
+bool DecodeRawSituation(const char *data, size_t size, RawSituation *raw) {
+  Cursor cursor(data, size);
+  return cursor.Get(&raw->time_stamp_, sizeof(raw->time_stamp_))
+      && cursor.GetRecords(&raw->machines_)
+      && cursor.GetSets(&raw->machine_sets_)
+      && cursor.GetSets(&raw->fair_sets_)
+      && cursor.GetRecords(&raw->jobs_)
+      && cursor.GetRecords(&raw->batches_)
+      && cursor.GetRecords(&raw->accounts_)
+      && cursor.GetRecords(&raw->change_costs_)
+      && cursor.Done();
+}
+
+ShmSegment::ShmSegment(const std::string &name, size_t buffer_capacity) {
+  bool create = buffer_capacity > 0;
+  ShmHeader header{};
+  int fd;
+  if (create) {
+    // Readers may still map the previous segment, so it is marked as closed and replaced,
+    // since truncating it would make their accesses fault.
+    int previous_fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (previous_fd != -1) {
+      uint32_t closed = 0;
+      PLOG_IF(WARNING, pwrite(previous_fd, &closed, sizeof(closed), 0) != sizeof(closed))
+          << "Closing shared memory " << name << " failed";
+      close(previous_fd);
+      shm_unlink(name.c_str());
+    }
+    fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd == -1) ThrowErrno("Creating shared memory " + name + " failed");
+    header.magic = ShmHeader::kMagic;
+    header.version = ShmHeader::kVersion;
+    header.buffer_capacity = buffer_capacity;
+    if (ftruncate(fd, kShmBuffersOffset + 2 * buffer_capacity) == -1
+        || pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+      close(fd);
+      ThrowErrno("Creating shared memory " + name + " failed");
+    }
+  } else {
+    fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd == -1) ThrowErrno("Opening shared memory " + name + " failed");
+    struct stat stat;
+    if (fstat(fd, &stat) == -1 || pread(fd, &header, sizeof(header), 0) != sizeof(header)
+        || header.magic != ShmHeader::kMagic || header.version != ShmHeader::kVersion
+        || static_cast<size_t>(stat.st_size) < kShmBuffersOffset + 2 * header.buffer_capacity) {
+      close(fd);
+      throw std::runtime_error("Invalid shared memory " + name);
+    }
+  }
+
+  buffer_capacity_ = header.buffer_capacity;
+  int protection = create ? PROT_READ | PROT_WRITE : PROT_READ;
+  void *data = mmap(nullptr, mapped_size(), protection, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) ThrowErrno("Mapping shared memory " + name + " failed");
+  header_ = static_cast<ShmHeader *>(data);
+}
+
+ShmSegment::~ShmSegment() {
+  PLOG_IF(WARNING, munmap(header_, mapped_size()) == -1) << "Unmapping shared memory failed";
+}
+
+ShmSituationPublisher::ShmSituationPublisher(const std::string &name, size_t buffer_capacity)
+    : segment_(name, buffer_capacity) {}
+
+bool ShmSituationPublisher::Publish(const RawSituation &raw) {
+  ShmHeader *header = segment_.header();
+  std::string data = EncodeRawSituation(raw);
+  if (data.size() > segment_.buffer_capacity()) {
+    LOG(WARNING) << "Situation of " << data.size() << " bytes does not fit in shared memory";
+    return false;
+  }
+
+  uint64_t published = __atomic_load_n(&header->published, __ATOMIC_RELAXED);
+  size_t buffer = published ? 1 - (published & 1) : 0;
+  uint64_t sequence = header->sequence[buffer];
+  __atomic_store_n(&header->sequence[buffer], sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  header->size[buffer] = data.size();
+  std::memcpy(segment_.buffer(buffer), data.data(), data.size());
+  __atomic_store_n(&header->sequence[buffer], sequence + 2, __ATOMIC_RELEASE);
+
+  uint64_t generation = (published >> 1) + 1;
+  __atomic_store_n(&header->published, generation << 1 | buffer, __ATOMIC_RELEASE);
+  return true;
+}
+
+void ShmReader::SetInputPath(const std::string &name) {
+  name_ = name;
+  segment_.reset();
+  last_generation_ = 0;
+}
+
+bool ShmReader::Read(RawSituation *destination) {
+  if (!segment_) {
+    try {
+      segment_.reset(new ShmSegment(name_, 0));
+    } catch (const std::exception &) {
+      // The driver has not created the segment yet.
+      return false;
+    }
+  }
+  const ShmHeader *header = segment_->header();
+  if (__atomic_load_n(&header->magic, __ATOMIC_RELAXED) != ShmHeader::kMagic) {
+    // The driver replaced the segment, the new one is mapped by the next Read().
+    SetInputPath(name_);
+    return false;
+  }
+  while (true) {
+    uint64_t published = __atomic_load_n(&header->published, __ATOMIC_ACQUIRE);
+    if (published >> 1 == last_generation_) return false;
+    size_t buffer = published & 1;
+    uint64_t sequence = __atomic_load_n(&header->sequence[buffer], __ATOMIC_ACQUIRE);
+    if (sequence & 1) continue;
+    uint64_t size = std::min<uint64_t>(header->size[buffer], segment_->buffer_capacity());
+    copy_.assign(segment_->buffer(buffer), size);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&header->sequence[buffer], __ATOMIC_RELAXED) != sequence) continue;
+
+    LSS_STATS_SCOPED_TIMER(Phase::kRead);
+    last_generation_ = published >> 1;
+    if (!DecodeRawSituation(copy_.data(), copy_.size(), destination)) {
+      LOG(WARNING) << "Invalid situation in shared memory " << name_;
+      *destination = RawSituation();
+      return false;
+    }
+    return true;
+  }
+}
+
+std::string ShmPath(const std::string &name) {
+  return "/dev/shm" + name;
+}
+
+ShmWriter::ShmWriter(const std::string &name, size_t capacity)
+    : JournalWriter(ShmPath(name), capacity) {}
+
+}  // namespace io
+}  // namespace lss
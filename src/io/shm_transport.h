@@ -0,0 +1,122 @@
+// This header provides a shared memory transport for a driver running on the same host
+// as the scheduler: ShmReader, which reads situations published by ShmSituationPublisher,
+// and ShmWriter, which passes assignments back.
+//
+// Situations are encoded in a binary format (EncodeRawSituation()) into one of the two
+// buffers of a POSIX shared memory segment. The publisher always writes to the buffer
+// which is not the published one and then publishes it, so readers are not disturbed by
+// the next situation unless it is published twice while they copy. Every buffer has its
+// own seqlock, so readers detect and retry such copies instead of locking.
+
+#ifndef LSS_IO_SHM_TRANSPORT_H_
+#define LSS_IO_SHM_TRANSPORT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "base/raw_situation.h"
+#include "io/journal_output.h"
+#include "io/reader.h"
+
+namespace lss {
+namespace io {
+
+struct ShmHeader {
+  static constexpr uint32_t kMagic = 0x4d48534c;  // "LSHM" in little endian.
+  static constexpr uint32_t kVersion = 1;
+
+  uint32_t magic;
+  uint32_t version;
+  uint64_t buffer_capacity;  // In bytes.
+  uint64_t published;        // Generation << 1 | buffer; 0 if nothing was published.
+  uint64_t sequence[2];      // Seqlocks of the buffers, odd while they are written.
+  uint64_t size[2];          // Sizes of situations in the buffers.
+};
+
+// Buffers start at this offset of the segment, one after another.
+static constexpr size_t kShmBuffersOffset = 64;
+
+static_assert(sizeof(ShmHeader) <= kShmBuffersOffset, "Header overlaps buffers");
+
+std::string EncodeRawSituation(const RawSituation &raw);
+
+// Replaces the contents of `raw`. Returns false if `size` bytes at `data` are not
+// a valid encoding.
+bool DecodeRawSituation(const char *data, size_t size, RawSituation *raw);
+
+// Maps the shared memory segment `name` (e.g. "/lss-input") and unmaps it on destruction.
+// Creates a segment with buffers of `buffer_capacity` bytes if it is not zero, otherwise
+// opens an existing one for reading. A created segment replaces the previous one, whose
+// magic is cleared so that its readers know they should open the segment again.
+class ShmSegment {
+ public:
+  ShmSegment(const std::string &name, size_t buffer_capacity);
+  ~ShmSegment();
+
+  ShmSegment(const ShmSegment &) = delete;
+  ShmSegment &operator=(const ShmSegment &) = delete;
+
+  ShmHeader *header() const { return header_; }
+  size_t buffer_capacity() const { return buffer_capacity_; }
+  char *buffer(size_t i) const {
+    return reinterpret_cast<char *>(header_) + kShmBuffersOffset + i * buffer_capacity_;
+  }
+
+ private:
+  size_t mapped_size() const { return kShmBuffersOffset + 2 * buffer_capacity_; }
+
+  size_t buffer_capacity_ = 0;
+  ShmHeader *header_ = nullptr;
+};
+
+// Driver side of ShmReader. There must be a single publisher per segment.
+class ShmSituationPublisher {
+ public:
+  static constexpr size_t kDefaultBufferCapacity = 64 << 20;
+
+  // Throws std::runtime_error if the segment cannot be created.
+  explicit ShmSituationPublisher(const std::string &name,
+                                 size_t buffer_capacity = kDefaultBufferCapacity);
+
+  // Returns false if the encoded situation does not fit in a buffer.
+  bool Publish(const RawSituation &raw);
+
+ private:
+  ShmSegment segment_;
+};
+
+// Reads every situation published to the segment named by the input path at most once.
+// The segment is mapped by the first Read() after it is created by the driver.
+class ShmReader : public Reader {
+ public:
+  explicit ShmReader(const std::string &name) : name_(name) {}
+
+  void SetInputPath(const std::string &name) override;
+
+  // Returns false if there is no segment or no situation newer than the last one read.
+  bool Read(RawSituation *destination) override;
+
+ private:
+  std::string name_;
+  std::unique_ptr<ShmSegment> segment_;
+  uint64_t last_generation_ = 0;
+  std::string copy_;
+};
+
+// JournalWriter (see journal_output.h) in the shared memory segment `name`. Assignments
+// need records whose taking and cancelling are decided atomically, so they are not passed
+// back as seqlocked snapshots like situations.
+class ShmWriter : public JournalWriter {
+ public:
+  explicit ShmWriter(const std::string &name, size_t capacity = kDefaultCapacity);
+};
+
+// Path of the shared memory segment `name` in the file system (Linux only).
+std::string ShmPath(const std::string &name);
+
+}  // namespace io
+}  // namespace lss
+
+#endif  // LSS_IO_SHM_TRANSPORT_H_
@@ -0,0 +1,136 @@
+#include "io/shm_transport.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "genetic/test_utils.h"
+
+namespace lss {
+namespace io {
+namespace {
+
+RawSituation Sample() {
+  RawSituation raw = genetic::GetSimpleRawSituation(3, 2);
+  raw.time_stamp(7.5);
+  raw.add(RawFairSet().id(3).add(0).add(1));
+  raw.add(RawAccount().id(2).alloc(0.5));
+  raw.jobs_[1].duration(2.5).context(Context(1, 2, 3));
+  return raw;
+}
+
+void ExpectEqual(const RawSituation &expected, const RawSituation &actual) {
+  EXPECT_EQ(expected.time_stamp_, actual.time_stamp_);
+  EXPECT_EQ(expected.jobs_, actual.jobs_);
+  EXPECT_EQ(expected.batches_, actual.batches_);
+  ASSERT_EQ(expected.machines_.size(), actual.machines_.size());
+  for (size_t i = 0; i < expected.machines_.size(); ++i) {
+    EXPECT_EQ(expected.machines_[i].id_, actual.machines_[i].id_);
+    EXPECT_EQ(expected.machines_[i].state_, actual.machines_[i].state_);
+  }
+  ASSERT_EQ(expected.machine_sets_.size(), actual.machine_sets_.size());
+  for (size_t i = 0; i < expected.machine_sets_.size(); ++i) {
+    EXPECT_EQ(expected.machine_sets_[i].id_, actual.machine_sets_[i].id_);
+    EXPECT_EQ(expected.machine_sets_[i].machines_, actual.machine_sets_[i].machines_);
+  }
+  ASSERT_EQ(expected.fair_sets_.size(), actual.fair_sets_.size());
+  for (size_t i = 0; i < expected.fair_sets_.size(); ++i) {
+    EXPECT_EQ(expected.fair_sets_[i].id_, actual.fair_sets_[i].id_);
+    EXPECT_EQ(expected.fair_sets_[i].machines_, actual.fair_sets_[i].machines_);
+  }
+  ASSERT_EQ(expected.accounts_.size(), actual.accounts_.size());
+  for (size_t i = 0; i < expected.accounts_.size(); ++i) {
+    EXPECT_EQ(expected.accounts_[i].id_, actual.accounts_[i].id_);
+    EXPECT_EQ(expected.accounts_[i].alloc_, actual.accounts_[i].alloc_);
+  }
+  ASSERT_EQ(expected.change_costs_.size(), actual.change_costs_.size());
+  for (size_t i = 0; i < expected.change_costs_.size(); ++i) {
+    EXPECT_EQ(expected.change_costs_[i].change_, actual.change_costs_[i].change_);
+    EXPECT_EQ(expected.change_costs_[i].cost_, actual.change_costs_[i].cost_);
+  }
+}
+
+TEST(RawSituationEncodingTest, RoundTrips) {
+  std::string data = EncodeRawSituation(Sample());
+  RawSituation decoded = RawSituation().add(RawJob().id(9));
+  ASSERT_TRUE(DecodeRawSituation(data.data(), data.size(), &decoded));
+  ExpectEqual(Sample(), decoded);
+}
+
+TEST(RawSituationEncodingTest, RejectsInvalidData) {
+  std::string data = EncodeRawSituation(Sample());
+  RawSituation decoded;
+  EXPECT_FALSE(DecodeRawSituation(data.data(), data.size() - 1, &decoded));
+  data.push_back('\0');
+  EXPECT_FALSE(DecodeRawSituation(data.data(), data.size(), &decoded));
+  // The number of machines is bigger than the data.
+  data[sizeof(Time) + 7] = 1;
+  EXPECT_FALSE(DecodeRawSituation(data.data(), data.size(), &decoded));
+}
+
+class ShmTransportTest : public ::testing::Test {
+ protected:
+  void SetUp() override { shm_unlink(name_.c_str()); }
+  void TearDown() override { shm_unlink(name_.c_str()); }
+
+  const std::string name_ = "/lss-shm-transport-test-" + std::to_string(getpid());
+};
+
+TEST_F(ShmTransportTest, ReaderReadsEverySituationOnce) {
+  ShmReader reader(name_);
+  RawSituation read;
+  EXPECT_FALSE(reader.Read(&read));
+
+  ShmSituationPublisher publisher(name_, 1 << 16);
+  EXPECT_FALSE(reader.Read(&read));
+  ASSERT_TRUE(publisher.Publish(Sample()));
+  ASSERT_TRUE(reader.Read(&read));
+  ExpectEqual(Sample(), read);
+  EXPECT_FALSE(reader.Read(&read));
+
+  RawSituation next = Sample().time_stamp(8.5);
+  ASSERT_TRUE(publisher.Publish(Sample()));
+  ASSERT_TRUE(publisher.Publish(next));
+  ASSERT_TRUE(reader.Read(&read));
+  ExpectEqual(next, read);
+  EXPECT_FALSE(reader.Read(&read));
+}
+
+TEST_F(ShmTransportTest, PublisherRejectsTooBigSituation) {
+  ShmSituationPublisher publisher(name_, 16);
+  EXPECT_FALSE(publisher.Publish(Sample()));
+}
+
+TEST_F(ShmTransportTest, ReaderFollowsReplacedSegment) {
+  ShmReader reader(name_);
+  RawSituation read;
+  {
+    ShmSituationPublisher publisher(name_, 1 << 16);
+    ASSERT_TRUE(publisher.Publish(Sample()));
+    ASSERT_TRUE(reader.Read(&read));
+  }
+  ShmSituationPublisher publisher(name_, 1 << 17);
+  EXPECT_FALSE(reader.Read(&read));
+  ASSERT_TRUE(publisher.Publish(Sample().time_stamp(1.)));
+  ASSERT_TRUE(reader.Read(&read));
+  EXPECT_EQ(1., read.time_stamp_);
+}
+
+TEST_F(ShmTransportTest, WriterPassesAssignmentsBack) {
+  ShmWriter writer(name_, 16);
+  JournalReader reader(ShmPath(name_));
+  EXPECT_TRUE(writer.Assign(1, 10));
+  JournalRecord record;
+  ASSERT_TRUE(reader.Next(&record));
+  EXPECT_EQ(10, record.job_id);
+  EXPECT_TRUE(reader.TryTake(record.sequence));
+  EXPECT_FALSE(writer.DoesAssignmentExist(1));
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace lss
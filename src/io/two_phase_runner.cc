@@ -0,0 +1,64 @@
+#include "io/two_phase_runner.h"
+
+#include <cstdint>
+#include <exception>
+#include <future>
+
+#include "glog/logging.h"
+
+namespace lss {
+namespace io {
+
+TwoPhaseRunner::TwoPhaseRunner(Algorithm *fast, Algorithm *refining,
+                               AssignmentsHandler *assignments_handler,
+                               std::chrono::milliseconds poll_interval)
+    : fast_(fast), refining_(refining), assignments_handler_(assignments_handler),
+      poll_interval_(poll_interval) {
+  refining_->SetIncumbent(incumbent_);
+}
+
+Schedule TwoPhaseRunner::Run(const Schedule &prev_schedule, Situation situation) {
+  incumbent_->Reset();
+  committed_ = fast_->Run(prev_schedule, situation);
+  committed_score_ = ObjectiveFunction(committed_, situation);
+  assignments_handler_->AdjustAssignments(committed_);
+  last_commits_ = 1;
+
+  // `situation` outlives the background thread, so it never frees the shared situation data.
+  Schedule fast_schedule = committed_;
+  std::future<Schedule> refined = std::async(std::launch::async, [&]() {
+    return refining_->Run(fast_schedule, situation);
+  });
+
+  uint64_t seen_version = 0;
+  while (refined.wait_for(poll_interval_) != std::future_status::ready) {
+    auto snapshot = incumbent_->Get();
+    if (!snapshot || snapshot->version == seen_version) continue;
+    seen_version = snapshot->version;
+    CommitIfBetter(snapshot->schedule, snapshot->fitness);
+  }
+
+  try {
+    Schedule schedule = refined.get();
+    CommitIfBetter(schedule, ObjectiveFunction(schedule, situation));
+  } catch (const std::exception &e) {
+    LOG(ERROR) << "Refining algorithm failed: " << e.what();
+  }
+  auto snapshot = incumbent_->Get();
+  if (snapshot && snapshot->version != seen_version)
+    CommitIfBetter(snapshot->schedule, snapshot->fitness);
+  LOG(INFO) << "Committed " << last_commits_ << " schedules, the last one scored "
+            << committed_score_;
+  return committed_;
+}
+
+void TwoPhaseRunner::CommitIfBetter(const Schedule &schedule, double score) {
+  if (score <= committed_score_) return;
+  committed_ = schedule;
+  committed_score_ = score;
+  assignments_handler_->AdjustAssignments(committed_);
+  ++last_commits_;
+}
+
+}  // namespace io
+}  // namespace lss
@@ -0,0 +1,49 @@
+#ifndef LSS_IO_TWO_PHASE_RUNNER_H_
+#define LSS_IO_TWO_PHASE_RUNNER_H_
+
+#include <chrono>
+#include <memory>
+
+#include "base/algorithm.h"
+#include "base/incumbent.h"
+#include "base/schedule.h"
+#include "base/situation.h"
+#include "io/assignment_handler.h"
+
+namespace lss {
+namespace io {
+
+// Runs a single cycle of the scheduler in two phases. The schedule of the `fast` algorithm
+// (e.g. greedy) is committed right away, so that idle machines get their jobs, and then
+// the `refining` algorithm runs on a background thread. Every `poll_interval` the schedule
+// it published to its incumbent is committed if it is better than the last committed one,
+// and so is the schedule it returns at the end. Committing goes through AssignmentsHandler,
+// so only assignments which machines have not taken yet are changed.
+class TwoPhaseRunner {
+ public:
+  TwoPhaseRunner(Algorithm *fast, Algorithm *refining, AssignmentsHandler *assignments_handler,
+                 std::chrono::milliseconds poll_interval);
+
+  // Returns the last committed schedule.
+  Schedule Run(const Schedule &prev_schedule, Situation situation);
+
+  // Number of schedules committed by the last Run(), including the fast one.
+  int last_commits() const { return last_commits_; }
+
+ private:
+  // `score` is ObjectiveFunction() of `schedule`, as are fitnesses of incumbent snapshots.
+  void CommitIfBetter(const Schedule &schedule, double score);
+
+  Algorithm *fast_, *refining_;
+  AssignmentsHandler *assignments_handler_;
+  std::chrono::milliseconds poll_interval_;
+  std::shared_ptr<Incumbent> incumbent_ = std::make_shared<Incumbent>();
+  Schedule committed_;
+  double committed_score_ = 0.;
+  int last_commits_ = 0;
+};
+
+}  // namespace io
+}  // namespace lss
+
+#endif  // LSS_IO_TWO_PHASE_RUNNER_H_
@@ -0,0 +1,94 @@
+#include "io/two_phase_runner.h"
+
+#include <chrono>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "base/algorithm_test_utils.h"
+#include "base/raw_situation.h"
+
+namespace lss {
+namespace io {
+namespace {
+
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::_;
+using namespace std::chrono_literals;
+
+// Every job is worth 1 on any machine.
+RawSituation Sample() {
+  RawSituation raw = RawSituation()
+      .add(RawMachine().id(0))
+      .add(RawMachine().id(1))
+      .add(RawMachine().id(2))
+      .add(RawMachineSet().id(0).add(0).add(1).add(2))
+      .add(RawAccount().id(0))
+      .add(RawBatch().id(0).account(0).job_reward(1).duration(1))
+      .add(RawJob().id(0).batch(0).machine_set(0).duration(1))
+      .add(RawJob().id(1).batch(0).machine_set(0).duration(1))
+      .add(RawJob().id(2).batch(0).machine_set(0).duration(1));
+  for (int i = 0; i < 8; ++i)
+    raw.add(RawChangeCost().change(Change(i & 1, i & 2, i & 4)).cost(0));
+  return raw;
+}
+
+class TwoPhaseRunnerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ON_CALL(writer_, Assign(_, _)).WillByDefault(Return(true));
+    ON_CALL(writer_, Unassign(_)).WillByDefault(Return(true));
+  }
+
+  Situation situation_{Sample()};
+  NiceMock<WriterMock> writer_;
+  AssignmentsHandler assignments_handler_{&writer_};
+};
+
+TEST_F(TwoPhaseRunnerTest, CommitsFastScheduleAndThenImprovements) {
+  AlgorithmFake fast(1);
+  AlgorithmFake refining(3, 2, 50ms);
+  TwoPhaseRunner runner(&fast, &refining, &assignments_handler_, 1ms);
+
+  // Assignments which do not change are not issued again.
+  EXPECT_CALL(writer_, Assign(0, 0)).Times(1);
+  EXPECT_CALL(writer_, Assign(1, 1)).Times(1);
+  EXPECT_CALL(writer_, Assign(2, 2)).Times(1);
+  EXPECT_CALL(writer_, Unassign(_)).Times(0);
+
+  Schedule schedule = runner.Run(Schedule(), situation_);
+  EXPECT_EQ(3, runner.last_commits());
+  EXPECT_EQ(3., ObjectiveFunction(schedule, situation_));
+}
+
+TEST_F(TwoPhaseRunnerTest, KeepsFastScheduleIfRefiningIsWorse) {
+  AlgorithmFake fast(2);
+  AlgorithmFake refining(1, 1);
+  TwoPhaseRunner runner(&fast, &refining, &assignments_handler_, 1ms);
+
+  EXPECT_CALL(writer_, Assign(0, 0)).Times(1);
+  EXPECT_CALL(writer_, Assign(1, 1)).Times(1);
+  EXPECT_CALL(writer_, Unassign(_)).Times(0);
+
+  Schedule schedule = runner.Run(Schedule(), situation_);
+  EXPECT_EQ(1, runner.last_commits());
+  EXPECT_EQ(2., ObjectiveFunction(schedule, situation_));
+}
+
+TEST_F(TwoPhaseRunnerTest, KeepsFastScheduleIfRefiningFails) {
+  AlgorithmFake fast(1);
+  FailingAlgorithm refining;
+  TwoPhaseRunner runner(&fast, &refining, &assignments_handler_, 1ms);
+
+  EXPECT_CALL(writer_, Assign(0, 0)).Times(1);
+
+  Schedule schedule = runner.Run(Schedule(), situation_);
+  EXPECT_EQ(1, runner.last_commits());
+  EXPECT_EQ(1., ObjectiveFunction(schedule, situation_));
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace lss
@@ -0,0 +1,71 @@
+#include "local_search/acceptance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace lss {
+namespace local_search {
+
+SimulatedAnnealing::SimulatedAnnealing(double initial_temperature, double cooling_rate,
+                                       Cooling cooling, FastRandom random)
+    : initial_temperature_(initial_temperature),
+      cooling_rate_(cooling_rate),
+      cooling_(cooling),
+      temperature_(initial_temperature),
+      random_(random) {
+  if (initial_temperature < 0)
+    throw std::invalid_argument("Temperature must be non-negative.");
+}
+
+bool SimulatedAnnealing::Accept(double current, double candidate) {
+  bool accept = candidate >= current;
+  if (!accept && temperature_ > 0) {
+    accept = random_.GetRealInRange(0, 1) < std::exp((candidate - current) / temperature_);
+  }
+  Cool();
+  return accept;
+}
+
+void SimulatedAnnealing::Cool() {
+  switch (cooling_) {
+    case Cooling::kGeometric:
+      temperature_ *= cooling_rate_;
+      break;
+    case Cooling::kLinear:
+      temperature_ = std::max(0., temperature_ - cooling_rate_);
+      break;
+  }
+}
+
+LateAcceptance::LateAcceptance(size_t history_length) : history_(history_length) {
+  if (history_length == 0)
+    throw std::invalid_argument("History length must be positive.");
+}
+
+void LateAcceptance::Reset(double initial_eval) {
+  std::fill(history_.begin(), history_.end(), initial_eval);
+  iteration_ = 0;
+}
+
+bool LateAcceptance::Accept(double current, double candidate) {
+  double &late = history_[iteration_++ % history_.size()];
+  bool accept = candidate >= current || candidate >= late;
+  late = accept ? candidate : current;
+  return accept;
+}
+
+ThresholdAccepting::ThresholdAccepting(double initial_threshold, double decay)
+    : initial_threshold_(initial_threshold), decay_(decay), threshold_(initial_threshold) {
+  if (initial_threshold < 0)
+    throw std::invalid_argument("Threshold must be non-negative.");
+}
+
+bool ThresholdAccepting::Accept(double current, double candidate) {
+  bool accept = candidate >= current - threshold_;
+  threshold_ *= decay_;
+  return accept;
+}
+
+}  // namespace local_search
+}  // namespace lss
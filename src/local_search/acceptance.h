@@ -0,0 +1,95 @@
+#ifndef LSS_LOCAL_SEARCH_ACCEPTANCE_H_
+#define LSS_LOCAL_SEARCH_ACCEPTANCE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "base/random.h"
+
+namespace lss {
+namespace local_search {
+
+// Decides whether a move which changed the evaluation of `State` from `current` to `candidate`
+// should be kept. Evaluations are maximized, so `candidate >= current` means the move
+// did not make the state worse.
+class Acceptance {
+ public:
+  // Called at the beginning of every LocalSearchAlgorithm::Run() with the evaluation
+  // of the initial state.
+  virtual void Reset(double initial_eval) = 0;
+
+  // Called exactly once per applied move.
+  virtual bool Accept(double current, double candidate) = 0;
+
+  virtual ~Acceptance() = default;
+};
+
+// Accepts only moves which do not worsen the evaluation.
+class HillClimbing : public Acceptance {
+ public:
+  void Reset(double) override {}
+  bool Accept(double current, double candidate) override { return candidate >= current; }
+};
+
+enum class Cooling {
+  kGeometric,  // The temperature is multiplied by `cooling_rate` after each move attempt.
+  kLinear,     // The temperature is decreased by `cooling_rate` after each move attempt.
+};
+
+// Accepts worsening moves with probability exp((candidate - current) / temperature).
+// `random` should be a stream independent of the one of the search, e.g. split from it.
+class SimulatedAnnealing : public Acceptance {
+ public:
+  SimulatedAnnealing(double initial_temperature, double cooling_rate, Cooling cooling,
+                     FastRandom random);
+
+  void Reset(double) override { temperature_ = initial_temperature_; }
+  bool Accept(double current, double candidate) override;
+
+  double temperature() const { return temperature_; }
+
+ private:
+  void Cool();
+
+  const double initial_temperature_;
+  const double cooling_rate_;
+  const Cooling cooling_;
+  double temperature_;
+  FastRandom random_;
+};
+
+// Late acceptance hill climbing: a move is accepted if it is not worse than either
+// the current evaluation or the evaluation from `history_length` move attempts ago.
+class LateAcceptance : public Acceptance {
+ public:
+  explicit LateAcceptance(size_t history_length);
+
+  void Reset(double initial_eval) override;
+  bool Accept(double current, double candidate) override;
+
+ private:
+  std::vector<double> history_;
+  size_t iteration_ = 0;
+};
+
+// Accepts moves which worsen the evaluation by at most `threshold`. The threshold
+// is multiplied by `decay` after each move attempt.
+class ThresholdAccepting : public Acceptance {
+ public:
+  ThresholdAccepting(double initial_threshold, double decay);
+
+  void Reset(double) override { threshold_ = initial_threshold_; }
+  bool Accept(double current, double candidate) override;
+
+  double threshold() const { return threshold_; }
+
+ private:
+  const double initial_threshold_;
+  const double decay_;
+  double threshold_;
+};
+
+}  // namespace local_search
+}  // namespace lss
+
+#endif  // LSS_LOCAL_SEARCH_ACCEPTANCE_H_
@@ -0,0 +1,84 @@
+#include "local_search/acceptance.h"
+
+#include "gtest/gtest.h"
+
+namespace lss {
+namespace local_search {
+namespace {
+
+// Verify that hill climbing accepts exactly the moves which do not worsen the evaluation.
+TEST(AcceptanceTest, HillClimbing) {
+  HillClimbing acceptance;
+  acceptance.Reset(0);
+  EXPECT_TRUE(acceptance.Accept(1, 2));
+  EXPECT_TRUE(acceptance.Accept(1, 1));
+  EXPECT_FALSE(acceptance.Accept(2, 1));
+}
+
+// Verify that annealing always accepts improvements and never accepts worsening moves
+// once the temperature dropped to zero.
+TEST(AcceptanceTest, SimulatedAnnealingCold) {
+  SimulatedAnnealing acceptance(0, 0.5, Cooling::kGeometric, FastRandom(0));
+  acceptance.Reset(0);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(acceptance.Accept(1, 2));
+    EXPECT_FALSE(acceptance.Accept(2, 1));
+  }
+}
+
+// Verify that a hot annealing accepts a worsening move sometimes, but not always.
+TEST(AcceptanceTest, SimulatedAnnealingHot) {
+  SimulatedAnnealing acceptance(1, 1, Cooling::kGeometric, FastRandom(0));
+  acceptance.Reset(0);
+  int accepted = 0;
+  for (int i = 0; i < 1000; ++i)
+    accepted += acceptance.Accept(1, 0);
+  // The acceptance probability is exp(-1) ~ 0.37.
+  EXPECT_GT(accepted, 250);
+  EXPECT_LT(accepted, 500);
+}
+
+// Verify both cooling schedules and that Reset() restores the initial temperature.
+TEST(AcceptanceTest, Cooling) {
+  SimulatedAnnealing geometric(8, 0.5, Cooling::kGeometric, FastRandom(0));
+  geometric.Reset(0);
+  geometric.Accept(0, 0);
+  geometric.Accept(0, 0);
+  EXPECT_NEAR(2, geometric.temperature(), 1e-9);
+  geometric.Reset(0);
+  EXPECT_NEAR(8, geometric.temperature(), 1e-9);
+
+  SimulatedAnnealing linear(1, 0.4, Cooling::kLinear, FastRandom(0));
+  linear.Reset(0);
+  linear.Accept(0, 0);
+  EXPECT_NEAR(0.6, linear.temperature(), 1e-9);
+  linear.Accept(0, 0);
+  linear.Accept(0, 0);
+  EXPECT_NEAR(0, linear.temperature(), 1e-9);
+}
+
+// Verify that late acceptance compares with the evaluation from `history_length` moves ago.
+TEST(AcceptanceTest, LateAcceptance) {
+  LateAcceptance acceptance(2);
+  acceptance.Reset(5);
+  EXPECT_TRUE(acceptance.Accept(10, 5));   // Not worse than the initial evaluation.
+  EXPECT_TRUE(acceptance.Accept(10, 10));  // Not worse than the current evaluation.
+  EXPECT_TRUE(acceptance.Accept(10, 7));   // The history holds {5, 10}.
+  EXPECT_FALSE(acceptance.Accept(10, 8));  // The history holds {7, 10}.
+  EXPECT_FALSE(acceptance.Accept(10, 6));  // The history holds {7, 10}.
+}
+
+TEST(AcceptanceTest, ThresholdAccepting) {
+  ThresholdAccepting acceptance(1, 0.5);
+  acceptance.Reset(0);
+  EXPECT_TRUE(acceptance.Accept(10, 9));
+  EXPECT_FALSE(acceptance.Accept(10, 9));
+  EXPECT_TRUE(acceptance.Accept(10, 9.75));
+  EXPECT_NEAR(0.125, acceptance.threshold(), 1e-9);
+  acceptance.Reset(0);
+  EXPECT_NEAR(1, acceptance.threshold(), 1e-9);
+}
+
+}  // namespace
+}  // namespace local_search
+}  // namespace lss
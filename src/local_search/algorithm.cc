@@ -1,26 +1,45 @@
 #include "local_search/algorithm.h"
 #include "local_search/state.h"
 
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
 #include "glog/logging.h"
 
 namespace lss {
 namespace local_search {
 
 LocalSearchAlgorithm::LocalSearchAlgorithm(int iterations, int seed)
-    : iterations_(iterations), random_(seed) {}
+    : LocalSearchAlgorithm(iterations, seed, std::make_shared<HillClimbing>()) {}
+
+LocalSearchAlgorithm::LocalSearchAlgorithm(int iterations, int seed,
+                                           std::shared_ptr<Acceptance> acceptance)
+    : LocalSearchAlgorithm(iterations, seed, acceptance, {std::make_shared<RelocateMove>()}) {}
+
+LocalSearchAlgorithm::LocalSearchAlgorithm(int iterations, int seed,
+                                           std::shared_ptr<Acceptance> acceptance,
+                                           std::vector<std::shared_ptr<Move>> moves)
+    : iterations_(iterations), random_(seed), acceptance_(acceptance), moves_(moves) {
+  if (moves_.empty()) throw std::invalid_argument("At least one move is required.");
+}
+
+constexpr int LocalSearchAlgorithm::kTraceInterval;
 
 Schedule LocalSearchAlgorithm::Run(const Schedule &, Situation situation) {
+  Schedule schedule = RunSearch(situation);
+  FlushTrace("local_search");
+  return schedule;
+}
+
+Schedule LocalSearchAlgorithm::RunSearch(Situation situation) {
   if (situation.jobs().empty())
     return Schedule(situation);
 
-  using range = std::uniform_int_distribution<size_t>;
-  auto rand_job = [this, &situation]() {
-    return situation.jobs()[range(0, situation.jobs().size() - 1)(random_)];
-  };
   auto rand_machine = [this, &situation](Job j) {
-    auto machines = j.machine_set().machines();
+    auto machines = j.machine_set().alive_machines();
     if (machines.empty()) return Machine();
-    return machines[range(0, machines.size() - 1)(random_)];
+    return machines[random_.Rand(machines.size())];
   };
 
   State state(situation);
@@ -37,23 +56,82 @@ Schedule LocalSearchAlgorithm::Run(const Schedule &, Situation situation) {
     }
   }
 
-  for (int i = 0; i < iterations_; ++i) {
-    double eval = state.Evaluate();
-    Job job = rand_job();
+  acceptance_->Reset(state.Evaluate());
+  // `best` is a copy of the best state seen so far. It is refreshed lazily - only when
+  // `state` is about to leave it by a worsening move - so that hill climbing never copies.
+  State best;
+  double best_eval = state.Evaluate();
+  bool at_best = true;
 
-    Machine old_machine = state.GetMachine(job);
-    size_t old_pos = state.GetPos(job);
-    state.Assign(Machine(), job);
+  OperatorSelector selector(moves_.size());
+  MoveJournal journal;
+  // Acceptance rate and time are measured over the iterations since the last trace point.
+  int applied = 0, accepted = 0;
+  auto trace_start = std::chrono::steady_clock::now();
+  auto add_trace_point = [&](int step) {
+    Trace *trace = this->trace();
+    if (!trace) return;
+    auto now = std::chrono::steady_clock::now();
+    TracePoint point;
+    point.step = step;
+    point.best = best_eval;
+    point.current = state.Evaluate();
+    point.acceptance_rate = applied ? static_cast<double>(accepted) / applied : 0.;
+    point.nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now - trace_start).count();
+    trace->Add(point);
+    trace_start = now;
+    applied = accepted = 0;
+  };
 
-    Machine new_machine = rand_machine(job);
-    size_t new_pos = range(0, state.QueueSize(new_machine) - 1)(random_);
-    state.Assign(new_machine, job, new_pos);
+  // The schedule is only built and scored when the best state improved since it was last
+  // published and its evaluation beats the incumbent's best fitness. `Evaluate()` only
+  // approximates the objective of the incumbent, so the incumbent still decides on publishing.
+  double published_eval = -std::numeric_limits<double>::infinity();
+  auto publish_best = [&]() {
+    if (!incumbent() || best_eval <= published_eval || best_eval <= incumbent()->best_fitness())
+      return;
+    published_eval = best_eval;
+    PublishToIncumbent(at_best ? state.ToSchedule() : best.ToSchedule(), situation);
+  };
 
-    if (state.Evaluate() < eval)
-      state.Assign(old_machine, job, old_pos);
+  int i = 0;
+  for (; i < iterations_; ++i) {
+    if (i % kTraceInterval == 0) {
+      if (i > 0 && DeadlinePassed()) break;
+      add_trace_point(i);
+      publish_best();
+    }
+
+    double eval = state.Evaluate();
+    size_t op = selector.Select(&random_);
+    journal.Clear();
+    if (!moves_[op]->Apply(situation, &state, &journal, &random_)) {
+      selector.Update(op, false);
+      continue;
+    }
+
+    double new_eval = state.Evaluate();
+    selector.Update(op, new_eval > eval);
+    ++applied;
+    if (!acceptance_->Accept(eval, new_eval)) {
+      journal.Undo(&state);
+      continue;
+    }
+    ++accepted;
+    if (new_eval > best_eval) {
+      best_eval = new_eval;
+      at_best = true;
+    } else if (new_eval < eval && at_best) {
+      journal.Undo(&state);
+      best = state;
+      journal.Redo(&state);
+      at_best = false;
+    }
   }
+  add_trace_point(i);
+  publish_best();
 
-  return state.ToSchedule();
+  return at_best ? state.ToSchedule() : best.ToSchedule();
 }
 
 }  // namespace local_search
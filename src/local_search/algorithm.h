@@ -1,10 +1,13 @@
 #ifndef LSS_LOCAL_SEARCH_ALGORITHM_H_
 #define LSS_LOCAL_SEARCH_ALGORITHM_H_
 
-#include <random>
+#include <memory>
+#include <vector>
 
 #include "base/algorithm.h"
 #include "base/schedule.h"
+#include "local_search/acceptance.h"
+#include "local_search/moves.h"
 
 namespace lss {
 namespace local_search {
@@ -15,13 +18,32 @@ class LocalSearchAlgorithm : public Algorithm {
   LocalSearchAlgorithm &operator=(const LocalSearchAlgorithm &) = delete;
 
   // `iterations` is the total number of move attempts per Run() call.
+  // Uses `HillClimbing` acceptance and `RelocateMove` only.
   explicit LocalSearchAlgorithm(int iterations, int seed);
 
+  // `acceptance` decides which moves are kept. Run() returns the best state seen,
+  // which need not be the final one if `acceptance` allows worsening moves.
+  LocalSearchAlgorithm(int iterations, int seed, std::shared_ptr<Acceptance> acceptance);
+
+  // The move applied in each iteration is chosen from `moves` by `OperatorSelector`,
+  // which favours moves that recently improved the evaluation.
+  LocalSearchAlgorithm(int iterations, int seed, std::shared_ptr<Acceptance> acceptance,
+                       std::vector<std::shared_ptr<Move>> moves);
+
   Schedule Run(const Schedule &, Situation situation) override;
 
+  // With tracing enabled, a point is recorded every `kTraceInterval` iterations.
+  // The best state is published to the incumbent and the deadline is checked
+  // at the same interval.
+  static constexpr int kTraceInterval = 1000;
+
  private:
+  Schedule RunSearch(Situation situation);
+
   const int iterations_;
-  std::default_random_engine random_;
+  RandomEngine random_;
+  std::shared_ptr<Acceptance> acceptance_;
+  std::vector<std::shared_ptr<Move>> moves_;
 };
 
 }  // namespace local_search
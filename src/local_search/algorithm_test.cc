@@ -1,8 +1,11 @@
 #include "local_search/algorithm.h"
 
 #include <algorithm>
+#include <chrono>
+#include <memory>
 #include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 namespace lss {
@@ -52,6 +55,95 @@ TEST(LocalSearchAlgorithm, CanImprove) {
   EXPECT_EQ(expected, schedule.GetAssignments().at(machine));
 }
 
+// Verify that algorithm finds the optimal schedule when choosing between all moves.
+TEST(LocalSearchAlgorithm, CanImproveWithAllMoves) {
+  std::vector<std::shared_ptr<Move>> moves{
+      std::make_shared<RelocateMove>(), std::make_shared<SwapMove>(),
+      std::make_shared<BlockMove>(), std::make_shared<ReverseMove>()};
+  LocalSearchAlgorithm algorithm(200, 0, std::make_shared<HillClimbing>(), moves);
+  Situation situation(kSample, false);
+  Schedule schedule(situation);
+  schedule = algorithm.Run(schedule, situation);
+
+  auto machine = situation[Id<Machine>(0)];
+  auto job = [&situation](int id) { return situation[Id<Job>(id)]; };
+  std::vector<Job> expected{job(0), job(2), job(3), job(1)};
+  EXPECT_EQ(expected, schedule.GetAssignments().at(machine));
+}
+
+// Verify that algorithm returns the best schedule seen, even if acceptance criterion
+// allowed it to wander off afterwards (here: a random walk which accepts every move).
+TEST(LocalSearchAlgorithm, ReturnsBest) {
+  auto acceptance = std::make_shared<ThresholdAccepting>(1e9, 1);
+  LocalSearchAlgorithm algorithm(1000, 0, acceptance);
+  Situation situation(kSample, false);
+  Schedule schedule(situation);
+  schedule = algorithm.Run(schedule, situation);
+
+  auto machine = situation[Id<Machine>(0)];
+  auto job = [&situation](int id) { return situation[Id<Job>(id)]; };
+  std::vector<Job> expected{job(0), job(2), job(3), job(1)};
+  EXPECT_EQ(expected, schedule.GetAssignments().at(machine));
+}
+
+// Verify that a trace point is recorded every kTraceInterval iterations and at the end.
+TEST(LocalSearchAlgorithm, Trace) {
+  const int kIterations = 2 * LocalSearchAlgorithm::kTraceInterval + 500;
+  LocalSearchAlgorithm algorithm(kIterations, 0, std::make_shared<HillClimbing>());
+  std::vector<TracePoint> points;
+  auto sink = std::make_shared<TraceSinkMock>();
+  EXPECT_CALL(*sink, Flush("local_search", ::testing::_, ::testing::_))
+      .Times(2)
+      .WillRepeatedly(::testing::Invoke(
+          [&points](const std::string &, int64_t, const Trace &trace) {
+            points = trace.Points();
+          }));
+  algorithm.SetTraceSink(sink);
+
+  Situation situation(kSample, false);
+  for (int run = 0; run < 2; ++run) {
+    algorithm.Run(Schedule(situation), situation);
+
+    ASSERT_EQ(4, points.size());
+    EXPECT_EQ(0, points[0].step);
+    EXPECT_EQ(LocalSearchAlgorithm::kTraceInterval, points[1].step);
+    EXPECT_EQ(kIterations, points[3].step);
+    for (size_t i = 0; i < points.size(); ++i) {
+      EXPECT_GE(points[i].best + 1e-9, points[i].current);
+      EXPECT_GE(points[i].acceptance_rate, 0);
+      EXPECT_LE(points[i].acceptance_rate, 1);
+      if (i > 0) {
+        EXPECT_GE(points[i].best, points[i - 1].best);
+      }
+    }
+  }
+}
+
+// Verify that the returned schedule is published to the incumbent with its objective.
+TEST(LocalSearchAlgorithm, PublishesToIncumbent) {
+  LocalSearchAlgorithm algorithm(20, 0);
+  auto incumbent = std::make_shared<Incumbent>();
+  algorithm.SetIncumbent(incumbent);
+  Situation situation(kSample, false);
+  Schedule schedule = algorithm.Run(Schedule(situation), situation);
+
+  auto snapshot = incumbent->Get();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_NEAR(ObjectiveFunction(schedule, situation), snapshot->fitness, 1e-9);
+  EXPECT_NEAR(snapshot->fitness, ObjectiveFunction(snapshot->schedule, situation), 1e-9);
+}
+
+// Verify that the search stops once the deadline passes.
+TEST(LocalSearchAlgorithm, StopsAtDeadline) {
+  LocalSearchAlgorithm algorithm(1e9, 0);
+  algorithm.SetDeadline(std::chrono::steady_clock::now());
+  Situation situation(kSample, false);
+  auto start = std::chrono::steady_clock::now();
+  Schedule schedule = algorithm.Run(Schedule(situation), situation);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+  EXPECT_EQ(situation.jobs().size(), schedule.jobs(situation[Id<Machine>(0)]).size());
+}
+
 }  // namespace
 }  // namespace local_search
 }  // namespace lss
@@ -0,0 +1,162 @@
+#include "local_search/moves.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace lss {
+namespace local_search {
+namespace {
+
+Job RandJob(Situation situation, RandomEngine *random) {
+  return situation.jobs()[random->Rand(situation.jobs().size())];
+}
+
+Machine RandMachine(Job job, RandomEngine *random) {
+  auto machines = job.machine_set().alive_machines();
+  if (machines.empty()) return Machine();
+  return machines[random->Rand(machines.size())];
+}
+
+bool CanRun(Job job, Machine machine) {
+  return job.machine_set().contains(machine) && machine.alive();
+}
+
+}  // namespace
+
+void MoveJournal::Assign(State *state, Machine machine, Job job, size_t pos) {
+  entries_.push_back({job, state->GetMachine(job), machine, state->GetPos(job), pos});
+  state->Assign(machine, job, pos);
+}
+
+void MoveJournal::Undo(State *state) const {
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it)
+    state->Assign(it->old_machine, it->job, it->old_pos);
+}
+
+void MoveJournal::Redo(State *state) const {
+  for (auto &entry : entries_)
+    state->Assign(entry.new_machine, entry.job, entry.new_pos);
+}
+
+bool RelocateMove::Apply(Situation situation, State *state, MoveJournal *journal,
+                         RandomEngine *random) const {
+  Job job = RandJob(situation, random);
+  journal->Assign(state, Machine(), job, 0);
+
+  Machine new_machine = RandMachine(job, random);
+  size_t new_pos = random->Rand(state->QueueSize(new_machine));
+  journal->Assign(state, new_machine, job, new_pos);
+  return true;
+}
+
+bool SwapMove::Apply(Situation situation, State *state, MoveJournal *journal,
+                     RandomEngine *random) const {
+  Job job1 = RandJob(situation, random), job2 = RandJob(situation, random);
+  Machine machine1 = state->GetMachine(job1), machine2 = state->GetMachine(job2);
+  if (job1 == job2 || !machine1 || !machine2
+      || !CanRun(job1, machine2) || !CanRun(job2, machine1))
+    return false;
+
+  size_t pos1 = state->GetPos(job1), pos2 = state->GetPos(job2);
+  if (machine1 == machine2 && pos1 > pos2) {
+    std::swap(job1, job2);
+    std::swap(pos1, pos2);
+  }
+  // On a single machine `job2` lands right before `job1`, which is then shifted to `pos2`.
+  // On different machines both removals happen before the respective insertions.
+  journal->Assign(state, machine1, job2, pos1);
+  journal->Assign(state, machine2, job1, pos2);
+  return true;
+}
+
+bool BlockMove::Apply(Situation situation, State *state, MoveJournal *journal,
+                      RandomEngine *random) const {
+  Job job = RandJob(situation, random);
+  Machine old_machine = state->GetMachine(job);
+  Machine new_machine = RandMachine(job, random);
+  if (!old_machine || !new_machine)
+    return false;
+
+  size_t first = state->GetPos(job), last = first;
+  while (first > 0 && state->QueueAt(old_machine, first - 1).batch() == job.batch())
+    --first;
+  while (last + 1 < state->QueueSize(old_machine)
+      && state->QueueAt(old_machine, last + 1).batch() == job.batch())
+    ++last;
+
+  std::vector<Job> block;
+  for (size_t pos = first; pos <= last; ++pos) {
+    Job j = state->QueueAt(old_machine, pos);
+    if (!CanRun(j, new_machine))
+      return false;
+    block.push_back(j);
+  }
+
+  // Remove from the back, so that the tail of the old queue is recomputed least.
+  for (auto it = block.rbegin(); it != block.rend(); ++it)
+    journal->Assign(state, Machine(), *it, 0);
+  size_t new_pos = random->Rand(state->QueueSize(new_machine) + 1);
+  for (size_t i = 0; i < block.size(); ++i)
+    journal->Assign(state, new_machine, block[i], new_pos + i);
+  return true;
+}
+
+bool ReverseMove::Apply(Situation situation, State *state, MoveJournal *journal,
+                        RandomEngine *random) const {
+  Machine machine = state->GetMachine(RandJob(situation, random));
+  size_t size = state->QueueSize(machine);
+  if (!machine || size < 2 || max_length_ < 2)
+    return false;
+
+  size_t first = random->Rand(size - 1);
+  size_t length = 2 + random->Rand(std::min(max_length_, size - first) - 1);
+  size_t last = first + length - 1;
+  // Moving the job at `last` to positions first, first + 1, ... reverses the segment.
+  for (size_t pos = first; pos < last; ++pos)
+    journal->Assign(state, machine, state->QueueAt(machine, last), pos);
+  return true;
+}
+
+OperatorSelector::OperatorSelector(size_t operators, double min_probability, double decay)
+    : success_rate_(operators, 1.),
+      min_probability_(std::min(min_probability, 1. / operators)),
+      decay_(decay) {
+  if (operators == 0)
+    throw std::invalid_argument("At least one operator is required.");
+}
+
+size_t OperatorSelector::Select(RandomEngine *random) const {
+  if (success_rate_.size() == 1)
+    return 0;
+
+  double total = TotalSuccessRate();
+  double rand = random->GetRealInRange(0, 1);
+  for (size_t op = 0; op + 1 < success_rate_.size(); ++op) {
+    rand -= Probability(op, total);
+    if (rand < 0) return op;
+  }
+  return success_rate_.size() - 1;
+}
+
+void OperatorSelector::Update(size_t op, bool success) {
+  success_rate_[op] = (1 - decay_) * success_rate_[op] + decay_ * success;
+}
+
+double OperatorSelector::Probability(size_t op) const {
+  return Probability(op, TotalSuccessRate());
+}
+
+double OperatorSelector::TotalSuccessRate() const {
+  return std::accumulate(success_rate_.begin(), success_rate_.end(), 0.);
+}
+
+double OperatorSelector::Probability(size_t op, double total) const {
+  double adaptive = 1 - min_probability_ * success_rate_.size();
+  if (total <= 0)
+    return 1. / success_rate_.size();
+  return min_probability_ + adaptive * success_rate_[op] / total;
+}
+
+}  // namespace local_search
+}  // namespace lss
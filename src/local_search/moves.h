@@ -0,0 +1,118 @@
+#ifndef LSS_LOCAL_SEARCH_MOVES_H_
+#define LSS_LOCAL_SEARCH_MOVES_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "base/random.h"
+#include "base/situation.h"
+#include "local_search/state.h"
+
+namespace lss {
+namespace local_search {
+
+// Draws the same numbers on every platform, unlike std distributions.
+using RandomEngine = FastRandom;
+
+// Records a sequence of `State::Assign` calls so that it can be reverted and replayed.
+class MoveJournal {
+ public:
+  // Calls `state->Assign(machine, job, pos)` and records where `job` was before.
+  void Assign(State *state, Machine machine, Job job, size_t pos);
+
+  // Reverts all recorded assignments (in reverse order).
+  void Undo(State *state) const;
+
+  // Replays all recorded assignments on `state` reverted by `Undo()`.
+  void Redo(State *state) const;
+
+  void Clear() { entries_.clear(); }
+  bool Empty() const { return entries_.empty(); }
+
+ private:
+  struct Entry {
+    Job job;
+    Machine old_machine, new_machine;
+    size_t old_pos, new_pos;
+  };
+
+  std::vector<Entry> entries_;
+};
+
+// A neighbourhood operator of local search. Moves keep jobs on machines from their
+// machine sets, provided that all jobs were assigned that way before.
+class Move {
+ public:
+  // Modifies `state` recording all changes in `journal`. Returns false if no
+  // applicable modification was found (`journal` is left empty then).
+  // `situation` must be the one `state` was constructed with and all jobs must be assigned.
+  virtual bool Apply(Situation situation, State *state, MoveJournal *journal,
+                     RandomEngine *random) const = 0;
+
+  virtual ~Move() = default;
+};
+
+// Moves a random job to a random position on a random machine from its machine set.
+class RelocateMove : public Move {
+ public:
+  bool Apply(Situation situation, State *state, MoveJournal *journal,
+             RandomEngine *random) const override;
+};
+
+// Exchanges positions (and machines) of two random jobs.
+class SwapMove : public Move {
+ public:
+  bool Apply(Situation situation, State *state, MoveJournal *journal,
+             RandomEngine *random) const override;
+};
+
+// Moves the maximal contiguous block of jobs from the same batch around a random job
+// to a random position on a random machine. As batch rewards depend on the last job
+// of the batch, moving single jobs of a batch rarely pays off.
+class BlockMove : public Move {
+ public:
+  bool Apply(Situation situation, State *state, MoveJournal *journal,
+             RandomEngine *random) const override;
+};
+
+// Reverses a random segment of at most `max_length` jobs in a machine queue (2-opt).
+class ReverseMove : public Move {
+ public:
+  explicit ReverseMove(size_t max_length = 16) : max_length_(max_length) {}
+
+  bool Apply(Situation situation, State *state, MoveJournal *journal,
+             RandomEngine *random) const override;
+
+ private:
+  size_t max_length_;
+};
+
+// Adaptive operator selection by probability matching. Each operator is chosen with
+// probability proportional to its exponentially weighted recent success rate, but never
+// less than `min_probability`.
+class OperatorSelector {
+ public:
+  // `decay` is the weight of the latest result in the success rate.
+  OperatorSelector(size_t operators, double min_probability = 0.05, double decay = 0.01);
+
+  // Does not use `random` if there is a single operator.
+  size_t Select(RandomEngine *random) const;
+  void Update(size_t op, bool success);
+
+  double Probability(size_t op) const;
+
+ private:
+  double TotalSuccessRate() const;
+  // `total` is TotalSuccessRate(), so that it is summed once per Select().
+  double Probability(size_t op, double total) const;
+
+  std::vector<double> success_rate_;
+  double min_probability_;
+  double decay_;
+};
+
+}  // namespace local_search
+}  // namespace lss
+
+#endif  // LSS_LOCAL_SEARCH_MOVES_H_
@@ -0,0 +1,214 @@
+#include "local_search/moves.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "base/raw_situation.h"
+
+namespace lss {
+namespace local_search {
+namespace {
+
+// Two machines in a common machine set and a third one usable only by jobs 6 and 7.
+const auto kSample = RawSituation()
+    .time_stamp(0)
+    .add(RawMachine().id(0))
+    .add(RawMachine().id(1))
+    .add(RawMachine().id(2))
+    .add(RawMachineSet().id(0).add(0).add(1))
+    .add(RawMachineSet().id(1).add(0).add(1).add(2))
+    .add(RawAccount().id(0))
+    .add(RawBatch().id(0).account(0).reward(1).timely_reward(1).duration(1).due(3))
+    .add(RawBatch().id(1).account(0).reward(1).timely_reward(2).duration(2).due(5))
+    .add(RawBatch().id(2).account(0).job_timely_reward(1).duration(1).due(4))
+    .add(RawJob().id(0).batch(0).machine_set(0).duration(1))
+    .add(RawJob().id(1).batch(0).machine_set(0).duration(2))
+    .add(RawJob().id(2).batch(0).machine_set(0).duration(1))
+    .add(RawJob().id(3).batch(1).machine_set(0).duration(3))
+    .add(RawJob().id(4).batch(1).machine_set(0).duration(1))
+    .add(RawJob().id(5).batch(2).machine_set(0).duration(2))
+    .add(RawJob().id(6).batch(2).machine_set(1).duration(1))
+    .add(RawJob().id(7).batch(2).machine_set(1).duration(1));
+
+class MovesTest : public ::testing::Test {
+ protected:
+  MovesTest() : situation_(kSample, false), state_(situation_), random_(0) {}
+
+  void SetUp() override {
+    for (int id = 0; id < 8; ++id)
+      state_.Assign(machine(id < 5 ? 0 : 1), job(id));
+  }
+
+  Machine machine(IdType id) const { return situation_[Id<Machine>(id)]; }
+  Job job(IdType id) const { return situation_[Id<Job>(id)]; }
+
+  std::vector<std::vector<Job>> Queues(const State &state) const {
+    std::vector<std::vector<Job>> queues;
+    for (Machine m : situation_.machines()) {
+      queues.emplace_back();
+      for (size_t pos = 0; pos < state.QueueSize(m); ++pos)
+        queues.back().push_back(state.QueueAt(m, pos));
+    }
+    return queues;
+  }
+
+  // Applies `move` many times checking that the state stays valid and that
+  // undo and redo work.
+  void CheckMove(const Move &move) {
+    int applied = 0;
+    for (int i = 0; i < 200; ++i) {
+      auto queues = Queues(state_);
+      double eval = state_.Evaluate();
+
+      MoveJournal journal;
+      if (!move.Apply(situation_, &state_, &journal, &random_)) {
+        EXPECT_TRUE(journal.Empty());
+        EXPECT_EQ(queues, Queues(state_));
+        continue;
+      }
+      ++applied;
+
+      EXPECT_EQ(0, state_.QueueSize(Machine()));
+      for (Job j : situation_.jobs()) {
+        auto machines = j.machine_set().machines();
+        EXPECT_NE(machines.end(), std::find(machines.begin(), machines.end(),
+                                            state_.GetMachine(j)));
+      }
+
+      auto new_queues = Queues(state_);
+      double new_eval = state_.Evaluate();
+      journal.Undo(&state_);
+      EXPECT_EQ(queues, Queues(state_));
+      EXPECT_NEAR(eval, state_.Evaluate(), 1e-9);
+      journal.Redo(&state_);
+      EXPECT_EQ(new_queues, Queues(state_));
+      EXPECT_NEAR(new_eval, state_.Evaluate(), 1e-9);
+    }
+    EXPECT_GT(applied, 0);
+  }
+
+  Situation situation_;
+  State state_;
+  RandomEngine random_{0};
+};
+
+TEST_F(MovesTest, Relocate) {
+  CheckMove(RelocateMove());
+}
+
+TEST_F(MovesTest, Swap) {
+  CheckMove(SwapMove());
+}
+
+TEST_F(MovesTest, Block) {
+  CheckMove(BlockMove());
+}
+
+TEST_F(MovesTest, Reverse) {
+  CheckMove(ReverseMove());
+}
+
+// Verify that swap exchanges exactly two jobs.
+TEST_F(MovesTest, SwapExchangesTwoJobs) {
+  auto queues = Queues(state_);
+  MoveJournal journal;
+  while (!SwapMove().Apply(situation_, &state_, &journal, &random_)) {}
+  auto new_queues = Queues(state_);
+
+  std::vector<Job> old_jobs, new_jobs;
+  for (size_t m = 0; m < queues.size(); ++m) {
+    ASSERT_EQ(queues[m].size(), new_queues[m].size());
+    for (size_t pos = 0; pos < queues[m].size(); ++pos) {
+      if (!(queues[m][pos] == new_queues[m][pos])) {
+        old_jobs.push_back(queues[m][pos]);
+        new_jobs.push_back(new_queues[m][pos]);
+      }
+    }
+  }
+  ASSERT_EQ(2, old_jobs.size());
+  EXPECT_EQ(old_jobs[0], new_jobs[1]);
+  EXPECT_EQ(old_jobs[1], new_jobs[0]);
+}
+
+// Verify that block move moves all contiguous jobs of a batch together.
+TEST_F(MovesTest, BlockMovesWholeBatch) {
+  State state(situation_);
+  state.Assign(machine(0), job(0));
+  state.Assign(machine(0), job(1));
+  state.Assign(machine(0), job(2));
+
+  int applied = 0;
+  for (int i = 0; i < 200; ++i) {
+    MoveJournal journal;
+    // Only assigned jobs can be moved.
+    applied += BlockMove().Apply(situation_, &state, &journal, &random_);
+    Machine m = state.GetMachine(job(0));
+    EXPECT_EQ(3, state.QueueSize(m));
+    for (int id = 0; id <= 2; ++id) {
+      EXPECT_EQ(m, state.GetMachine(job(id)));
+      EXPECT_EQ(id, state.GetPos(job(id)));
+    }
+  }
+  EXPECT_GT(applied, 0);
+}
+
+// Verify that reverse move reverses a single contiguous segment of a queue.
+TEST_F(MovesTest, ReverseReversesSegment) {
+  for (int i = 0; i < 50; ++i) {
+    auto queues = Queues(state_);
+    MoveJournal journal;
+    ASSERT_TRUE(ReverseMove().Apply(situation_, &state_, &journal, &random_));
+    auto new_queues = Queues(state_);
+
+    int changed = 0;
+    for (size_t m = 0; m < queues.size(); ++m) {
+      if (queues[m] == new_queues[m]) continue;
+      ++changed;
+      auto &q = queues[m];
+      auto first = std::mismatch(q.begin(), q.end(), new_queues[m].begin()).first;
+      auto last = std::mismatch(q.rbegin(), q.rend(), new_queues[m].rbegin()).first.base();
+      std::reverse(first, last);
+      EXPECT_EQ(q, new_queues[m]);
+    }
+    EXPECT_EQ(1, changed);
+  }
+}
+
+TEST(OperatorSelectorTest, SingleOperator) {
+  OperatorSelector selector(1);
+  RandomEngine random(0);
+  EXPECT_EQ(0, selector.Select(&random));
+  EXPECT_NEAR(1, selector.Probability(0), 1e-9);
+}
+
+// Verify that successful operators are chosen more often, but no operator starves.
+TEST(OperatorSelectorTest, Adapts) {
+  OperatorSelector selector(3, 0.1, 0.1);
+  for (size_t op = 0; op < 3; ++op)
+    EXPECT_NEAR(1. / 3, selector.Probability(op), 1e-9);
+
+  for (int i = 0; i < 100; ++i) {
+    selector.Update(0, false);
+    selector.Update(1, true);
+    selector.Update(2, false);
+  }
+  EXPECT_GT(selector.Probability(1), 0.75);
+  EXPECT_GE(selector.Probability(0), 0.1);
+  EXPECT_NEAR(1, selector.Probability(0) + selector.Probability(1) + selector.Probability(2),
+              1e-9);
+
+  RandomEngine random(0);
+  int chosen[3] = {};
+  for (int i = 0; i < 1000; ++i)
+    ++chosen[selector.Select(&random)];
+  EXPECT_GT(chosen[1], chosen[0] + chosen[2]);
+  EXPECT_GT(chosen[0], 0);
+  EXPECT_GT(chosen[2], 0);
+}
+
+}  // namespace
+}  // namespace local_search
+}  // namespace lss
@@ -1,11 +1,12 @@
 #include "local_search/state.h"
 
 #include <algorithm>
-#include <cmath>
 #include <exception>
 
 #include "glog/logging.h"
 
+#include "base/sigmoid.h"
+
 namespace lss {
 namespace local_search {
 
@@ -55,6 +56,12 @@ Job State::QueueBack(Machine m) const {
   return it->second.back().job;
 }
 
+Job State::QueueAt(Machine m, size_t pos) const {
+  auto it = queue_.find(m);
+  if (it == queue_.end()) throw std::invalid_argument("Invalid machine.");
+  return it->second.at(pos).job;
+}
+
 void State::Assign(Machine new_machine, Job job, size_t new_pos) {
   auto new_queue_it = queue_.find(new_machine);
   if (new_queue_it == queue_.end()) throw std::invalid_argument("Invalid machine.");
@@ -68,11 +75,11 @@ void State::Assign(Machine new_machine, Job job, size_t new_pos) {
   size_t old_pos = JobPos(old_queue, job);
   eval_ -= old_queue[old_pos].eval_contribution;
   old_queue.erase(old_queue.begin() + old_pos);
-  RecomputeTail(&old_queue, old_pos);
+  RecomputeTail(assignment, &old_queue, old_pos);
 
   new_pos = std::min(new_pos, new_queue.size());
   new_queue.insert(new_queue.begin() + new_pos, Entry(job));
-  RecomputeTail(&new_queue, new_pos);
+  RecomputeTail(new_machine, &new_queue, new_pos);
 
   assignment = new_machine;
 }
@@ -80,33 +87,45 @@ void State::Assign(Machine new_machine, Job job, size_t new_pos) {
 double State::JobEval(Job j, Time finish_time) const {
   Batch b = j.batch();
 
-  double r = (finish_time - j.batch().due()) / b.duration();
-  double job_reward = b.job_reward() + b.job_timely_reward() / (1 + exp(r));
-  double batch_reward = b.reward() + b.timely_reward() / (1 + exp(r));
+  double sigmoid = Sigmoid((finish_time - j.batch().due()) / b.duration());
+  double job_reward = b.job_reward() + b.job_timely_reward() * sigmoid;
+  double batch_reward = b.reward() + b.timely_reward() * sigmoid;
 
   return job_reward + batch_reward / b.jobs().size();
 }
 
-Time State::EstimatedStartTime(const MachineQueue &queue, size_t pos) const {
-  // TODO(kzyla): Take into account the job currently being executed by given machine.
-  if (pos == 0)
-    return situation_.time_stamp();
-  else
+Cost State::SetupCost(Context from, Context to) const {
+  return situation_.change_costs().setup_cost(from, to);
+}
+
+Time State::EstimatedStartTime(Machine m, const MachineQueue &queue, size_t pos) const {
+  if (pos > 0)
     return queue[pos - 1].finish_time;
+
+  return m.free_time();
+}
+
+Context State::PrecedingContext(Machine m, const MachineQueue &queue, size_t pos) const {
+  if (pos > 0)
+    return queue[pos - 1].job.context();
+  return m.last_context();
 }
 
-void State::RecomputeTail(MachineQueue *queue, size_t pos) {
+void State::RecomputeTail(Machine m, MachineQueue *queue, size_t pos) {
   CHECK_NOTNULL(queue);
   // Unassigned jobs are not taken into account by `Evaluate()`.
-  if (queue == &queue_.at(Machine())) return;
+  if (!m) return;
 
-  Time time = EstimatedStartTime(*queue, pos);
+  Time time = EstimatedStartTime(m, *queue, pos);
+  Context context = PrecedingContext(m, *queue, pos);
   for (size_t i = pos; i < queue->size(); ++i) {
-    time += (*queue)[i].job.duration();
+    Job job = (*queue)[i].job;
+    time += SetupCost(context, job.context()) + job.duration();
+    context = job.context();
     (*queue)[i].finish_time = time;
 
     eval_ -= (*queue)[i].eval_contribution;
-    (*queue)[i].eval_contribution = JobEval((*queue)[i].job, time);
+    (*queue)[i].eval_contribution = JobEval(job, time);
     eval_ += (*queue)[i].eval_contribution;
   }
 }
@@ -29,6 +29,9 @@ class State {
   explicit State(Situation situation);
 
   // Returns an approximation of objective function for schedule represented by this `State`.
+  // Jobs are charged setup time for the change from the context of the previous job
+  // in the queue, or from the current context of the machine for the first job.
+  // The first job waits for the job currently being executed by the machine (if any).
   // Complexity: O(1).
   double Evaluate() const { return eval_; }
 
@@ -48,6 +51,10 @@ class State {
   // Complexity: O(1).
   Job QueueBack(Machine m) const;
 
+  // Throws `std::out_of_range` if `pos >= QueueSize(m)`.
+  // Complexity: O(1).
+  Job QueueAt(Machine m, size_t pos) const;
+
   // Adds `j` at the end of job queue of `m`.
   // Complexity: O(QueueSize(GetMachine(j))).
   void Assign(Machine m, Job j) { Assign(m, j, std::numeric_limits<size_t>::max()); }
@@ -69,8 +76,13 @@ class State {
   using MachineQueue = std::vector<Entry>;
 
   double JobEval(Job j, Time finish_time) const;
-  Time EstimatedStartTime(const MachineQueue &queue, size_t pos) const;
-  void RecomputeTail(MachineQueue *queue, size_t pos);
+  // Components of `from` equal to `Context::kNone` (unknown) are not considered changed.
+  Cost SetupCost(Context from, Context to) const;
+  // The time at which the job at position `pos` of `queue` can start (barring setup time).
+  Time EstimatedStartTime(Machine m, const MachineQueue &queue, size_t pos) const;
+  // The context of `m` right before the job at position `pos` of `queue` starts.
+  Context PrecedingContext(Machine m, const MachineQueue &queue, size_t pos) const;
+  void RecomputeTail(Machine m, MachineQueue *queue, size_t pos);
 
   // Performs a linear search starting at the end. This will be significantly faster than
   // starting at the beginning for typical use of `State`.
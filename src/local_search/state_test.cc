@@ -119,6 +119,103 @@ TEST_F(StateTest, SimpleEvaluation) {
   }
 }
 
+// Verify that setup times are charged between consecutive jobs and from the context
+// of the machine, by comparing with a situation where they are added to job durations.
+TEST_F(StateTest, SetupTime) {
+  auto raw = RawSituation()
+      .time_stamp(0)
+      .add(RawMachine().id(0).context(Context(1, 1, Context::kNone)))
+      .add(RawMachineSet().id(0).add(0))
+      .add(RawAccount().id(0))
+      .add(RawBatch().id(0).account(0).duration(1).timely_reward(1).due(3))
+      .add(RawBatch().id(1).account(0).duration(1).timely_reward(1).due(4))
+      .add(RawJob().id(0).batch(0).machine_set(0).duration(1).context(Context(1, 2, 3)))
+      .add(RawJob().id(1).batch(1).machine_set(0).duration(1).context(Context(2, 2, 4)));
+  for (int i = 0; i < Change::kNum; ++i)
+    raw.add(RawChangeCost().change(Change(i & 1, i & 2, i & 4)).cost(i));
+  auto expected_raw = raw;
+  expected_raw.jobs_[0].duration(1 + 2);  // Change (0, 1, 0); the third context is unknown.
+  expected_raw.jobs_[1].duration(1 + 5);  // Change (1, 0, 1).
+
+  auto eval = [](const RawSituation &raw) {
+    Situation situation(raw, false);
+    State state(situation);
+    state.Assign(situation[Id<Machine>(0)], situation[Id<Job>(0)]);
+    state.Assign(situation[Id<Machine>(0)], situation[Id<Job>(1)]);
+    return state.Evaluate();
+  };
+  for (auto &change_cost : expected_raw.change_costs_) change_cost.cost(0);
+  EXPECT_NEAR(eval(expected_raw), eval(raw), 1e-9);
+}
+
+// Verify that the first job waits for the job being executed by the machine.
+TEST_F(StateTest, RunningJob) {
+  auto raw = RawSituation()
+      .time_stamp(10)
+      .add(RawMachine().id(0))
+      .add(RawMachineSet().id(0).add(0))
+      .add(RawAccount().id(0))
+      .add(RawBatch().id(0).account(0).duration(1).timely_reward(1).due(12))
+      .add(RawJob().id(0).batch(0).machine_set(0).duration(1))
+      .add(RawJob().id(1).batch(0).machine_set(0).duration(5).start_time(8).machine(0));
+
+  auto eval = [](const RawSituation &raw) {
+    Situation situation(raw, false);
+    State state(situation);
+    state.Assign(situation[Id<Machine>(0)], situation[Id<Job>(0)]);
+    return state.Evaluate();
+  };
+  auto expected_raw = raw;
+  expected_raw.jobs_[1].machine(kIdNone);
+  expected_raw.time_stamp(8 + 5);
+  EXPECT_NEAR(eval(expected_raw), eval(raw), 1e-9);
+}
+
+// Verify that State and ObjectiveFunction() charge the same setup times, including those
+// after the running job and from partially unknown machine contexts. Batches have single
+// jobs, as State splits batch rewards among their jobs.
+TEST_F(StateTest, SameEvaluationAsObjectiveFunction) {
+  auto raw = RawSituation()
+      .time_stamp(10)
+      .add(RawMachine().id(0).context(Context(1, Context::kNone, 1)))
+      .add(RawMachine().id(1).context(Context(1, 1, 1)))
+      .add(RawMachineSet().id(0).add(0).add(1))
+      .add(RawAccount().id(0))
+      .add(RawJob().id(0).batch(0).machine_set(0).duration(2).context(Context(1, 2, 3)))
+      .add(RawJob().id(1).batch(1).machine_set(0).duration(1).context(Context(2, 2, 3)))
+      .add(RawJob().id(2).batch(2).machine_set(0).duration(3).context(Context(2, 1, 1)))
+      .add(RawJob().id(3).batch(3).machine_set(0).duration(1).context(Context(1, 1, 2)))
+      .add(RawJob().id(4).batch(4).machine_set(0).duration(4).context(Context(3, 3, 3))
+               .start_time(8).machine(1));
+  for (IdType b = 0; b < 5; ++b) {
+    raw.add(RawBatch().id(b).account(0).duration(2).due(12 + 2 * b)
+                .reward(1).timely_reward(2).job_reward(0.5).job_timely_reward(1));
+  }
+  for (int i = 0; i < Change::kNum; ++i)
+    raw.add(RawChangeCost().change(Change(i & 1, i & 2, i & 4)).cost(i));
+
+  Situation situation(raw, false);
+  State state(situation);
+  Machine m0 = situation[Id<Machine>(0)], m1 = situation[Id<Machine>(1)];
+  // Unassigned jobs (the running one included) are ignored by State, but ToSchedule() keeps
+  // them in the queue of the null machine, so only the machine queues are compared.
+  auto objective = [&]() {
+    Schedule schedule(situation);
+    for (Machine m : {m0, m1})
+      for (size_t pos = 0; pos < state.QueueSize(m); ++pos)
+        schedule.AssignJob(m, state.QueueAt(m, pos));
+    return ObjectiveFunction(schedule, situation);
+  };
+  state.Assign(m0, situation[Id<Job>(0)]);
+  state.Assign(m0, situation[Id<Job>(2)]);
+  state.Assign(m1, situation[Id<Job>(1)]);
+  state.Assign(m1, situation[Id<Job>(3)]);
+  EXPECT_NEAR(objective(), state.Evaluate(), 1e-9);
+
+  state.Assign(m0, situation[Id<Job>(1)], 0);
+  EXPECT_NEAR(objective(), state.Evaluate(), 1e-9);
+}
+
 TEST_F(StateTest, ToSchedule) {
   State state(situation_);
 
@@ -172,6 +269,15 @@ TEST_F(StateTest, QueueBack) {
   EXPECT_EQ(job1_, state.QueueBack(Machine()));
 }
 
+TEST_F(StateTest, QueueAt) {
+  State state(situation_);
+  state.Assign(machine_, job0_);
+  state.Assign(machine_, job1_, 0);
+  EXPECT_EQ(job1_, state.QueueAt(machine_, 0));
+  EXPECT_EQ(job0_, state.QueueAt(machine_, 1));
+  EXPECT_THROW(state.QueueAt(machine_, 2), std::out_of_range);
+}
+
 }  // namespace
 }  // namespace local_search
 }  // namespace lss
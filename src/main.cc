@@ -1,15 +1,23 @@
 #include <chrono>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "boost/program_options.hpp"
 #include "glog/logging.h"
 
 #include "base/algorithm.h"
+#include "base/random.h"
+#include "base/portfolio.h"
 #include "base/schedule.h"
-#include "genetic/algorithm.h"
+#include "base/stats.h"
+#include "base/trace.h"
+#include "genetic/static_algorithm.h"
+#include "genetic/permutation_chromosome/batch_evaluator.h"
 #include "genetic/permutation_chromosome/moves_impl.h"
 #include "genetic/selector_impl.h"
 #include "greedy_new/algorithm.h"
@@ -17,13 +25,26 @@
 #include "io/assignment_handler.h"
 #include "io/basic_input.h"
 #include "io/basic_output.h"
+#include "io/checkpoint.h"
+#include "io/delta_input.h"
+#include "io/journal_output.h"
+#include "io/shm_transport.h"
+#include "io/two_phase_runner.h"
 
 namespace program_opt = boost::program_options;
 
 using std::cout;
 using std::string;
 using lss::local_search::LocalSearchAlgorithm;
-using GeneticAlgorithm = lss::genetic::GeneticAlgorithm<lss::genetic::PermutationJobMachine>;
+using lss::genetic::PermutationJobMachine;
+using GeneticAlgorithm = lss::genetic::StaticGeneticAlgorithm<
+    PermutationJobMachine,
+    lss::genetic::GreedyInitializer,
+    lss::genetic::StaticSelector<PermutationJobMachine, lss::genetic::BatchEvaluator,
+                                 lss::FastRandom>,
+    lss::genetic::StaticCrosser<lss::FastRandom>,
+    lss::genetic::StaticMutator<lss::FastRandom>,
+    lss::FastRandom>;
 using lss::greedy_new::GreedyAlgorithm;
 using namespace std::chrono_literals;
 
@@ -43,11 +64,64 @@ program_opt::variables_map ProcessCommandLine(int argc, char **argv) {
   program_opt::options_description desc("Scheduler options");
   desc.add_options()
       ("help,h", "produce help message")
-      ("input,i", program_opt::value<string>()->required(), "Set input file path")
-      ("assignments,a", program_opt::value<string>()->required(), "Set assignments directory path")
+      ("input,i", program_opt::value<string>(), "Set input file path")
+      ("input-format", program_opt::value<string>()->default_value("basic"),
+       "Choose input file format (basic/delta); delta files contain changes since the previous "
+       "file")
+      ("shm", program_opt::value<string>()->default_value(""),
+       "Set name prefix (e.g. /lss) of shared memory segments used instead of the input file "
+       "(<prefix>-input) and the assignments directory (<prefix>-assignments)")
+      ("assignments,a", program_opt::value<string>(), "Set assignments directory path")
+      ("journal", program_opt::value<string>()->default_value(""),
+       "Set path of the assignments journal, which is used instead of the assignments directory")
       ("verbose,v", program_opt::value<int>(), "Set verbosity level")
       ("algorithm", program_opt::value<string>(),
-       "Choose algorithm to run (genetic/local_search/greedy)");
+       "Choose algorithm to run (genetic/local_search/greedy/portfolio)")
+      ("portfolio", program_opt::value<string>()->default_value("greedy,local_search,genetic"),
+       "Choose comma separated algorithms run in parallel by the portfolio algorithm")
+      ("time-budget", program_opt::value<int>()->default_value(1000),
+       "Set time budget in milliseconds of a single run of the portfolio algorithm")
+      ("commit-fast", program_opt::bool_switch(),
+       "Commit the greedy schedule first and then improvements found by the algorithm")
+      ("poll-interval", program_opt::value<int>()->default_value(100),
+       "Set interval in milliseconds between checks for improvements in commit-fast mode")
+      ("acceptance", program_opt::value<string>()->default_value("hill_climbing"),
+       "Choose local search acceptance criterion "
+       "(hill_climbing/annealing/late_acceptance/threshold)")
+      ("temperature", program_opt::value<double>()->default_value(1.),
+       "Set initial temperature of simulated annealing")
+      ("cooling", program_opt::value<string>()->default_value("geometric"),
+       "Choose cooling schedule of simulated annealing (geometric/linear)")
+      ("cooling-rate", program_opt::value<double>()->default_value(0.99999),
+       "Set temperature factor (geometric) or decrement (linear) per iteration")
+      ("history-length", program_opt::value<int>()->default_value(1000),
+       "Set history length of late acceptance hill climbing")
+      ("threshold", program_opt::value<double>()->default_value(0.1),
+       "Set initial threshold of threshold accepting")
+      ("threshold-decay", program_opt::value<double>()->default_value(0.99999),
+       "Set threshold factor per iteration of threshold accepting")
+      ("moves", program_opt::value<string>()->default_value("relocate,swap,block,reverse"),
+       "Choose comma separated local search moves (relocate/swap/block/reverse)")
+      ("stats-file", program_opt::value<string>()->default_value(""),
+       "Set path of the file periodically overwritten with latency statistics")
+      ("stats-interval", program_opt::value<int>()->default_value(60),
+       "Set interval in seconds between statistics dumps")
+      ("checkpoint-file", program_opt::value<string>()->default_value(""),
+       "Set path of the file periodically overwritten with the state of the scheduler, "
+       "which is restored from it at startup")
+      ("checkpoint-interval", program_opt::value<int>()->default_value(10),
+       "Set interval in seconds between checkpoints")
+      ("trace-file", program_opt::value<string>()->default_value(""),
+       "Set path of the file to which progress of the algorithm is appended after every run")
+      ("trace-format", program_opt::value<string>()->default_value("csv"),
+       "Choose format of the trace file (csv/json)")
+      ("seed", program_opt::value<int>(),
+       "Set seed of random number generators (based on the current time by default)")
+      ("mutations", program_opt::value<string>()->default_value("machine"),
+       "Choose comma separated mutations of the genetic algorithm "
+       "(machine/swap/inversion/insert)")
+      ("imbalance-factor", program_opt::value<double>()->default_value(0.),
+       "Set weight of the fair-share imbalance in the objective of the genetic algorithm");
   program_opt::store(program_opt::parse_command_line(argc, argv, desc), variables_map);
 
   if (variables_map.count("help")) {
@@ -59,42 +133,189 @@ program_opt::variables_map ProcessCommandLine(int argc, char **argv) {
 }
 
 static
-std::unique_ptr<GeneticAlgorithm> BuildGeneticAlgorithm() {
-  using lss::genetic::PermutationJobMachine;
-  using lss::genetic::InitializerImpl;
-  using lss::genetic::EvaluatorImpl;
-  using lss::genetic::SelectorImpl;
-  using lss::genetic::CrosserImpl;
-  using lss::genetic::MutatorImpl;
-  using lss::genetic::ConfigurableMoves;
+std::vector<lss::genetic::Mutation> BuildMutations(const program_opt::variables_map &config) {
+  using lss::genetic::Mutation;
+
+  std::vector<Mutation> mutations;
+  std::istringstream names(config["mutations"].as<string>());
+  string name;
+  while (std::getline(names, name, ',')) {
+    if (name == "machine") {
+      mutations.push_back(Mutation::kMachine);
+    } else if (name == "swap") {
+      mutations.push_back(Mutation::kSwap);
+    } else if (name == "inversion") {
+      mutations.push_back(Mutation::kInversion);
+    } else if (name == "insert") {
+      mutations.push_back(Mutation::kInsert);
+    } else {
+      LOG(ERROR)
+          << "Unknown mutation (valid values for mutations flag are: "
+              "machine, swap, inversion, insert)\n";
+      exit(1);
+    }
+  }
+  if (mutations.empty()) {
+    LOG(ERROR) << "At least one mutation is required\n";
+    exit(1);
+  }
+  return mutations;
+}
+
+static
+std::unique_ptr<GeneticAlgorithm> BuildGeneticAlgorithm(
+    const program_opt::variables_map &config, int seed) {
+  using lss::genetic::GreedyInitializer;
+  using lss::genetic::BatchEvaluator;
+  using lss::genetic::StaticSelector;
+  using lss::genetic::StaticCrosser;
+  using lss::genetic::StaticMutator;
 
   int population_size = 20;
   int number_of_generations = 100;
   double crossover_probability = 0.1;
   double mutation_probability = 0.01;
+  double greedy_fraction = 0.2;
+  double greedy_noise = 0.1;
 
-  auto rand = std::make_shared<lss::Random>();
-  auto initializer = std::make_shared<InitializerImpl>(rand);
-  auto evaluator = std::make_shared<EvaluatorImpl>();
-  auto selector = std::make_shared<SelectorImpl<PermutationJobMachine>>(evaluator, rand);
-  auto crosser = std::make_shared<CrosserImpl>(rand);
-  auto mutator = std::make_shared<MutatorImpl>(mutation_probability, rand);
-  auto moves = std::make_shared<ConfigurableMoves<PermutationJobMachine>>();
-  (*moves)
-      .SetInitializer(initializer)
-      .SetSelector(selector)
-      .SetCrosser(crosser)
-      .SetSelector(selector)
-      .SetMutator(mutator);
+  // Every move gets its own stream; the first one is used by the initializer.
+  lss::FastRandom rand(seed);
+  GreedyInitializer initializer(std::make_shared<lss::Random>(seed, rand.Split()), greedy_fraction,
+                                greedy_noise);
+  BatchEvaluator evaluator(BatchEvaluator::Isa::kAuto, config["imbalance-factor"].as<double>());
+  StaticSelector<PermutationJobMachine, BatchEvaluator, lss::FastRandom> selector(evaluator,
+                                                                                rand.Split());
+  StaticCrosser<lss::FastRandom> crosser(rand.Split());
+  StaticMutator<lss::FastRandom> mutator(mutation_probability, rand.Split(),
+                                         BuildMutations(config));
 
   return std::make_unique<GeneticAlgorithm>(population_size, number_of_generations,
-                                            crossover_probability, moves, rand);
+                                            crossover_probability, initializer, selector,
+                                            crosser, mutator, rand);
+}
+
+static
+std::shared_ptr<lss::local_search::Acceptance> BuildAcceptance(
+    const program_opt::variables_map &config, lss::FastRandom random) {
+  using lss::local_search::Cooling;
+
+  string name = config["acceptance"].as<string>();
+  if (name == "hill_climbing") {
+    return std::make_shared<lss::local_search::HillClimbing>();
+  } else if (name == "annealing") {
+    string cooling_name = config["cooling"].as<string>();
+    if (cooling_name != "geometric" && cooling_name != "linear") {
+      LOG(ERROR) << "Unknown cooling schedule (valid values are: geometric, linear)\n";
+      exit(1);
+    }
+    Cooling cooling = cooling_name == "geometric" ? Cooling::kGeometric : Cooling::kLinear;
+    return std::make_shared<lss::local_search::SimulatedAnnealing>(
+        config["temperature"].as<double>(), config["cooling-rate"].as<double>(), cooling, random);
+  } else if (name == "late_acceptance") {
+    return std::make_shared<lss::local_search::LateAcceptance>(
+        config["history-length"].as<int>());
+  } else if (name == "threshold") {
+    return std::make_shared<lss::local_search::ThresholdAccepting>(
+        config["threshold"].as<double>(), config["threshold-decay"].as<double>());
+  }
+  LOG(ERROR)
+      << "Unknown acceptance (valid values for acceptance flag are: "
+          "hill_climbing, annealing, late_acceptance, threshold)\n";
+  exit(1);
 }
 
 static
-std::unique_ptr<LocalSearchAlgorithm> BuildLocalSearchAlgorithm() {
+std::vector<std::shared_ptr<lss::local_search::Move>> BuildMoves(
+    const program_opt::variables_map &config) {
+  std::vector<std::shared_ptr<lss::local_search::Move>> moves;
+  std::istringstream names(config["moves"].as<string>());
+  string name;
+  while (std::getline(names, name, ',')) {
+    if (name == "relocate") {
+      moves.push_back(std::make_shared<lss::local_search::RelocateMove>());
+    } else if (name == "swap") {
+      moves.push_back(std::make_shared<lss::local_search::SwapMove>());
+    } else if (name == "block") {
+      moves.push_back(std::make_shared<lss::local_search::BlockMove>());
+    } else if (name == "reverse") {
+      moves.push_back(std::make_shared<lss::local_search::ReverseMove>());
+    } else {
+      LOG(ERROR)
+          << "Unknown move (valid values for moves flag are: "
+              "relocate, swap, block, reverse)\n";
+      exit(1);
+    }
+  }
+  if (moves.empty()) {
+    LOG(ERROR) << "At least one local search move is required\n";
+    exit(1);
+  }
+  return moves;
+}
+
+static
+std::unique_ptr<LocalSearchAlgorithm> BuildLocalSearchAlgorithm(
+    const program_opt::variables_map &config, int seed) {
   static const int kIterations = 1e6;
-  return std::make_unique<LocalSearchAlgorithm>(kIterations, time(nullptr));
+  // The search draws from the stream seeded with `seed`, the acceptance from the next one.
+  lss::FastRandom acceptance_random(seed);
+  acceptance_random.engine().Jump();
+  return std::make_unique<LocalSearchAlgorithm>(kIterations, seed,
+                                                BuildAcceptance(config, acceptance_random),
+                                                BuildMoves(config));
+}
+
+// Returns nullptr if `name` is not a valid algorithm name.
+static
+std::unique_ptr<lss::Algorithm> BuildAlgorithm(const string &name,
+                                               const program_opt::variables_map &config,
+                                               int seed) {
+  if (name == "local_search") {
+    return BuildLocalSearchAlgorithm(config, seed);
+  } else if (name == "genetic") {
+    return BuildGeneticAlgorithm(config, seed);
+  } else if (name == "greedy") {
+    return std::make_unique<GreedyAlgorithm>();
+  }
+  return nullptr;
+}
+
+static
+std::unique_ptr<lss::PortfolioAlgorithm> BuildPortfolioAlgorithm(
+    const program_opt::variables_map &config, int seed) {
+  std::vector<lss::PortfolioAlgorithm::Entry> entries;
+  std::istringstream names(config["portfolio"].as<string>());
+  string name;
+  while (std::getline(names, name, ',')) {
+    // Algorithms get different seeds, so that the same algorithm can be run multiple times.
+    auto algorithm = BuildAlgorithm(name, config, seed + entries.size());
+    if (!algorithm) {
+      LOG(ERROR)
+          << "Unknown algorithm (valid values for portfolio flag are: "
+              "genetic, local_search, greedy)\n";
+      exit(1);
+    }
+    entries.push_back({name, std::move(algorithm)});
+  }
+  if (entries.empty()) {
+    LOG(ERROR) << "At least one portfolio algorithm is required\n";
+    exit(1);
+  }
+  return std::make_unique<lss::PortfolioAlgorithm>(
+      std::move(entries), std::chrono::milliseconds(config["time-budget"].as<int>()));
+}
+
+static
+std::shared_ptr<lss::TraceSink> BuildTraceSink(const program_opt::variables_map &config,
+                                               std::ostream *output) {
+  string format = config["trace-format"].as<string>();
+  if (format == "csv") {
+    return std::make_shared<lss::CsvTraceSink>(output);
+  } else if (format == "json") {
+    return std::make_shared<lss::JsonTraceSink>(output);
+  }
+  LOG(ERROR) << "Unknown trace format (valid values for trace-format flag are: csv, json)\n";
+  exit(1);
 }
 
 int main(int argc, char **argv) {
@@ -102,36 +323,131 @@ int main(int argc, char **argv) {
   ConfigLogger(argv, config["verbose"].as<int>());
   LOG(INFO) << "Scheduler start";
 
-  lss::io::BasicReader reader(config["input"].as<string>());
-  lss::io::BasicWriter writer(config["assignments"].as<string>());
-  lss::io::AssignmentsHandler assignments_handler(&writer);
+  const string shm = config["shm"].as<string>();
+  std::unique_ptr<lss::io::Reader> reader;
+  if (!shm.empty()) {
+    reader = std::make_unique<lss::io::ShmReader>(shm + "-input");
+  } else if (config.count("input")) {
+    const string input_format = config["input-format"].as<string>();
+    if (input_format == "basic") {
+      reader = std::make_unique<lss::io::BasicReader>(config["input"].as<string>());
+    } else if (input_format == "delta") {
+      reader = std::make_unique<lss::io::DeltaReader>(config["input"].as<string>());
+    } else {
+      LOG(ERROR) << "Unknown input format (valid values for input-format flag are: "
+                    "basic, delta)\n";
+      exit(1);
+    }
+  } else {
+    LOG(ERROR) << "Either input file or shared memory is required\n";
+    exit(1);
+  }
+  std::unique_ptr<lss::io::Writer> writer;
+  if (!shm.empty()) {
+    writer = std::make_unique<lss::io::ShmWriter>(shm + "-assignments");
+  } else if (!config["journal"].as<string>().empty()) {
+    writer = std::make_unique<lss::io::JournalWriter>(config["journal"].as<string>());
+  } else if (config.count("assignments")) {
+    writer = std::make_unique<lss::io::BasicWriter>(config["assignments"].as<string>());
+  } else {
+    LOG(ERROR) << "Either assignments directory or journal is required\n";
+    exit(1);
+  }
+  lss::io::AssignmentsHandler assignments_handler(writer.get());
   lss::Schedule schedule;
+  lss::StatsDumper stats_dumper(config["stats-file"].as<string>(),
+                                std::chrono::seconds(config["stats-interval"].as<int>()));
+
+  // The schedule is restored and committed once the first situation is built.
+  std::unique_ptr<lss::io::CheckpointWriter> checkpoint_writer;
+  lss::io::Checkpoint checkpoint;
+  bool restore_schedule = false;
+  const string checkpoint_path = config["checkpoint-file"].as<string>();
+  if (!checkpoint_path.empty()) {
+    if (lss::io::ReadCheckpoint(checkpoint_path, &checkpoint)) {
+      LOG(INFO) << "Restoring checkpoint " << checkpoint_path;
+      assignments_handler.Restore(checkpoint.assignments);
+      restore_schedule = true;
+    }
+    checkpoint_writer = std::make_unique<lss::io::CheckpointWriter>(
+        checkpoint_path, std::chrono::seconds(config["checkpoint-interval"].as<int>()));
+  }
+
+  // Logged so that the run can be replayed with --seed.
+  int seed = config.count("seed") ? config["seed"].as<int>() : time(nullptr);
+  LOG(INFO) << "Random seed: " << seed;
 
   std::unique_ptr<lss::Algorithm> algorithm;
   std::string algorithm_name = config["algorithm"].as<string>();
-  if (algorithm_name == "local_search") {
-    algorithm = BuildLocalSearchAlgorithm();
-  } else if (algorithm_name == "genetic") {
-    algorithm = BuildGeneticAlgorithm();
-  } else if (algorithm_name == "greedy") {
-    algorithm = std::make_unique<GreedyAlgorithm>();
+  if (algorithm_name == "portfolio") {
+    algorithm = BuildPortfolioAlgorithm(config, seed);
   } else {
+    algorithm = BuildAlgorithm(algorithm_name, config, seed);
+  }
+  if (!algorithm) {
     LOG(ERROR)
         << "Unknown algorithm (valid values for algorithm flag are: "
-            "genetic, local_search, greedy)\n";
+            "genetic, local_search, greedy, portfolio)\n";
     exit(1);
   }
 
+  // In commit-fast mode the greedy schedule is committed first.
+  GreedyAlgorithm fast_algorithm;
+  std::unique_ptr<lss::io::TwoPhaseRunner> two_phase_runner;
+  if (config["commit-fast"].as<bool>()) {
+    two_phase_runner = std::make_unique<lss::io::TwoPhaseRunner>(
+        &fast_algorithm, algorithm.get(), &assignments_handler,
+        std::chrono::milliseconds(config["poll-interval"].as<int>()));
+  }
+
+  std::ofstream trace_output;
+  if (!config["trace-file"].as<string>().empty()) {
+    trace_output.open(config["trace-file"].as<string>(), std::ios::app);
+    algorithm->SetTraceSink(BuildTraceSink(config, &trace_output));
+  }
+
+  // Kept between reads, so that DeltaReader copies only the sections which changed.
+  lss::RawSituation raw;
   while (true) {
-    lss::RawSituation raw;
-    while (!reader.Read(&raw)) {
+    while (!reader->Read(&raw)) {
       lss::io::NotifyDriverIFinishedCompute();
       std::this_thread::sleep_for(100ms);
     }
-    assignments_handler.AdjustRawSituation(&raw);
-    lss::Situation situation = lss::Situation(raw, lss::Situation::BuildMode::kDropInvalid);
-    schedule = algorithm->Run(schedule, situation);
-    assignments_handler.AdjustAssignments(schedule);
+    {
+      LSS_STATS_SCOPED_TIMER(lss::Phase::kAdjustRawSituation);
+      assignments_handler.AdjustRawSituation(&raw);
+    }
+    lss::Situation situation;
+    {
+      LSS_STATS_SCOPED_TIMER(lss::Phase::kBuildSituation);
+      situation = lss::Situation(raw, lss::Situation::BuildMode::kDropInvalid);
+    }
+    if (restore_schedule) {
+      // Algorithms do not start from the previous schedule, so the restored one is committed
+      // right away: machines get the jobs planned before the restart while the first run lasts.
+      LSS_STATS_SCOPED_TIMER(lss::Phase::kAdjustAssignments);
+      schedule = lss::io::RestoreSchedule(checkpoint.schedule, situation);
+      assignments_handler.AdjustAssignments(schedule);
+      restore_schedule = false;
+    }
+    if (two_phase_runner) {
+      // Assignments are adjusted during the run.
+      LSS_STATS_SCOPED_TIMER(lss::Phase::kRun);
+      schedule = two_phase_runner->Run(schedule, situation);
+    } else {
+      {
+        LSS_STATS_SCOPED_TIMER(lss::Phase::kRun);
+        schedule = algorithm->Run(schedule, situation);
+      }
+      LSS_STATS_SCOPED_TIMER(lss::Phase::kAdjustAssignments);
+      assignments_handler.AdjustAssignments(schedule);
+    }
+    if (checkpoint_writer)
+      checkpoint_writer->Tick(assignments_handler, schedule);
+    LSS_STATS_ADD(lss::StatCounter::kCycles, 1);
+    LSS_STATS_ADD(lss::StatCounter::kJobs, situation.jobs().size());
+    LSS_STATS_ADD(lss::StatCounter::kMachines, situation.machines().size());
+    LSS_STATS_TICK(stats_dumper);
   }
 
   LOG(ERROR) << "Scheduler stop";
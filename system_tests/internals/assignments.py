@@ -0,0 +1,138 @@
+import os
+import mmap
+import struct
+import logging
+import threading
+
+LOGGER = logging.getLogger('test_runner')
+
+
+class DirectoryAssignments:
+    """Assignments written by the scheduler as one file per machine (BasicWriter)."""
+
+    def __init__(self, lss_assignments_dir):
+        self.__dir = lss_assignments_dir
+
+    def take(self, machine_id):
+        """Returns the id of the job assigned to the machine or None if there is no assignment."""
+        assignment_file = os.path.join(self.__dir, str(machine_id))
+        taken_file = assignment_file + '-taken'
+        try:
+            os.rename(assignment_file, taken_file)
+        except FileNotFoundError:
+            return None
+        with open(taken_file, 'rt') as f:
+            return int(f.read())
+
+
+# Layout of the journal, see src/io/journal_output.h.
+HEADER = struct.Struct('<IIQQ')
+RECORD = struct.Struct('<QIIqqII')
+CHECKSUMMED = struct.Struct('<QIqq')
+TAKE = struct.Struct('<I')
+MAGIC = 0x4e4a534c
+VERSION = 1
+RECORDS_OFFSET = 64
+TAKE_OFFSET = 32
+CANCELLED_OFFSET = 36
+
+ASSIGN = 1
+UNASSIGN = 2
+TAKING = 1
+TAKEN = 2
+BACKED_OFF = 3
+
+
+def checksum(sequence, record_type, machine_id, job_id):
+    """FNV-1a of the fields, like JournalChecksum()."""
+    result = 2166136261
+    for byte in CHECKSUMMED.pack(sequence, record_type, machine_id, job_id):
+        result = ((result ^ byte) * 16777619) & 0xffffffff
+    return result
+
+
+# Acquiring a lock executes an atomic read-modify-write instruction, which is a full
+# memory barrier - Python has no other way to order a store before a load.
+_FENCE = threading.Lock()
+
+
+def fence():
+    with _FENCE:
+        pass
+
+
+class JournalAssignments:
+    """Assignments appended by the scheduler to a memory mapped journal (JournalWriter).
+
+    The journal is tailed before taking a job, so that the latest assignment of every
+    machine is known. It is opened once the scheduler creates it.
+    """
+
+    def __init__(self, lss_journal_path):
+        self.__path = lss_journal_path
+        self.__journal = None
+        self.__capacity = 0
+        self.__next = 1
+        self.__pending = {}  # Machine id -> (sequence, job id)
+
+    def take(self, machine_id):
+        """Returns the id of the job assigned to the machine or None if there is no assignment."""
+        if not self.__open():
+            return None
+        self.__tail()
+        if machine_id not in self.__pending:
+            return None
+        sequence, job_id = self.__pending.pop(machine_id)
+        return job_id if self.__try_take(sequence) else None
+
+    def __open(self):
+        if self.__journal:
+            return True
+        try:
+            with open(self.__path, 'r+b') as f:
+                journal = mmap.mmap(f.fileno(), 0)
+        except (FileNotFoundError, ValueError):
+            return False
+        magic, version, capacity, _ = HEADER.unpack_from(journal, 0)
+        if magic != MAGIC or version != VERSION or \
+                len(journal) < RECORDS_OFFSET + capacity * RECORD.size:
+            journal.close()
+            return False
+        self.__journal = journal
+        self.__capacity = capacity
+        return True
+
+    def __offset(self, sequence):
+        return RECORDS_OFFSET + (sequence - 1) % self.__capacity * RECORD.size
+
+    def __head(self):
+        return HEADER.unpack_from(self.__journal, 0)[3]
+
+    def __tail(self):
+        head = self.__head()
+        if head - self.__next >= self.__capacity:
+            LOGGER.warning('Journal reader lost records %s-%s', self.__next, head - self.__capacity)
+            self.__next = head - self.__capacity + 1
+        while self.__next <= head:
+            sequence, record_type, record_checksum, machine_id, job_id, _, _ = \
+                RECORD.unpack_from(self.__journal, self.__offset(self.__next))
+            if sequence != self.__next or \
+                    record_checksum != checksum(sequence, record_type, machine_id, job_id):
+                LOGGER.warning('Journal reader skipped invalid record %s', self.__next)
+            elif record_type == ASSIGN:
+                self.__pending[machine_id] = (sequence, job_id)
+            elif record_type == UNASSIGN:
+                self.__pending.pop(machine_id, None)
+            self.__next += 1
+
+    def __try_take(self, sequence):
+        """Mirrors JournalReader::TryTake()."""
+        offset = self.__offset(sequence)
+        if RECORD.unpack_from(self.__journal, offset)[0] != sequence or \
+                TAKE.unpack_from(self.__journal, offset + CANCELLED_OFFSET)[0]:
+            return False
+        TAKE.pack_into(self.__journal, offset + TAKE_OFFSET, TAKING)
+        fence()
+        cancelled = TAKE.unpack_from(self.__journal, offset + CANCELLED_OFFSET)[0]
+        TAKE.pack_into(self.__journal, offset + TAKE_OFFSET, BACKED_OFF if cancelled else TAKEN)
+        return not cancelled
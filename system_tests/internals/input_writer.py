@@ -3,11 +3,18 @@ import os
 from internals import utils
 
 
+# Every DELTA_SNAPSHOT_INTERVAL-th input in the delta format is a snapshot anyway.
+DELTA_SNAPSHOT_INTERVAL = 100
+
+
 class InputWriter:
 
-    def __init__(self, lss_input_path, story):
+    def __init__(self, lss_input_path, story, delta=False):
         self.__lss_input_path = lss_input_path
         self.__story = story
+        self.__delta = delta
+        self.__number = 0
+        self.__previous = None  # Section -> {record key -> line} of the previous input.
 
     def write(self, machines, ready_jobs, machine_sets, fair_sets):
         pieces = [
@@ -23,7 +30,39 @@ class InputWriter:
         def glue(title, data):
             return [title] + data + ['']
 
-        self.__write_input_file(utils.flatten(glue(*p) for p in pieces))
+        if self.__delta:
+            self.__write_input_file(self.__delta_lines(pieces))
+        else:
+            self.__write_input_file(utils.flatten(glue(*p) for p in pieces))
+
+    def __delta_lines(self, pieces):
+        """Lines of the next input in the delta format (see src/io/delta_input.h).
+
+        A snapshot is written if the scheduler has not read the previous input yet, since
+        it would be replaced and the next delta would not apply.
+        """
+        self.__number += 1
+        current = {title: {record_key(title, line): line for line in lines}
+                   for title, lines in pieces}
+        snapshot = self.__previous is None or \
+            os.path.exists(self.__lss_input_path) or \
+            self.__number % DELTA_SNAPSHOT_INTERVAL == 0
+        if snapshot:
+            result = ['snapshot %d' % self.__number]
+            for title, records in current.items():
+                result += [title] + list(records.values()) + ['']
+        else:
+            result = ['delta %d' % self.__number]
+            for title, records in current.items():
+                previous = self.__previous[title]
+                removed = [key for key in previous if key not in records]
+                changed = [line for key, line in records.items() if previous.get(key) != line]
+                if removed:
+                    result += ['removed-' + title] + removed + ['']
+                if changed:
+                    result += [title] + changed + ['']
+        self.__previous = current
+        return result
 
     def __write_input_file(self, lines):
         tmp_path = self.__lss_input_path + '-new'
@@ -33,6 +72,12 @@ class InputWriter:
         os.rename(tmp_path, self.__lss_input_path)
 
 
+def record_key(title, line):
+    """Records are identified by ids, except context changes identified by changes."""
+    fields = line.split()
+    return ' '.join(fields[:3]) if title == 'context-changes' else fields[0]
+
+
 def show_fields(fields):
     return ' '.join([str(field) for field in fields])
 
@@ -1,11 +1,8 @@
-import os
 import logging
 from enum import IntEnum
 
 from internals.exceptions import InvalidJobException
 
-LSS_ASSIGNMENTS_DIR = 'assignments'
-
 LOGGER = logging.getLogger('test_runner')
 
 
@@ -17,11 +14,10 @@ class MachineState(IntEnum):
 
 class Machine:
 
-    def __init__(self, machine_id, lss_assignments_dir, context_changes_costs):
+    def __init__(self, machine_id, lss_assignments, context_changes_costs):
         self.__id = machine_id
         self.__state = MachineState.MACHINE_IDLE
-        self.__lss_assignment_file = os.path.join(lss_assignments_dir, str(self.__id))
-        self.__taken_file = self.__lss_assignment_file + '-taken'
+        self.__lss_assignments = lss_assignments
         self.__context = (-1, -1, -1)
         self.__context_changes_costs = context_changes_costs
         self.finish_event_args = None
@@ -35,9 +31,8 @@ class Machine:
 
     def try_to_take_job(self, now, ready_jobs):
         assert self.__state == MachineState.MACHINE_IDLE
-        try:
-            job = self.__get_assigned_job(ready_jobs)
-        except FileNotFoundError:
+        job = self.__get_assigned_job(ready_jobs)
+        if job is None:
             finish_event_args = []
             return finish_event_args
         self.__state = MachineState.MACHINE_WORKING
@@ -63,9 +58,9 @@ class Machine:
             self.finish_event_args = None
 
     def __get_assigned_job(self, ready_jobs):
-        os.rename(self.__lss_assignment_file, self.__taken_file)
-        with open(self.__taken_file, 'rt') as f:
-            job_id = int(f.read())
+        job_id = self.__lss_assignments.take(self.__id)
+        if job_id is None:
+            return None
         if job_id not in ready_jobs:
             raise InvalidJobException(
                 job_id,
@@ -15,10 +15,10 @@ LOGGER = logging.getLogger('test_runner')
 
 class State:
 
-    def __init__(self, story, lss_input_path, lss_assignments_dir):
+    def __init__(self, story, lss_input_path, lss_assignments, delta_input=False):
         self.__story = story
-        self.__input_writer = InputWriter(lss_input_path, story)
-        self.__lss_assignment_dir = lss_assignments_dir
+        self.__input_writer = InputWriter(lss_input_path, story, delta_input)
+        self.__lss_assignments = lss_assignments
         self.__machines = {}
         self.__machine_sets = defaultdict(set)
         self.__fair_sets = defaultdict(set)
@@ -80,7 +80,7 @@ class State:
         else:
             self.__machines[machine_id] = Machine(
                 machine_id,
-                self.__lss_assignment_dir,
+                self.__lss_assignments,
                 self.__story.get_raw('context_changes')
             )
 
@@ -90,7 +90,7 @@ class State:
         else:
             self.__machines[machine_id] = Machine(
                 machine_id,
-                self.__lss_assignment_dir,
+                self.__lss_assignments,
                 self.__story.get_raw('context_changes')
             )
             self.__machines[machine_id].kill()
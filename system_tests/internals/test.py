@@ -8,6 +8,7 @@ import json
 
 from internals import timer
 from internals import utils
+from internals.assignments import DirectoryAssignments, JournalAssignments
 from internals.loop import EventLoop
 from internals.machine import MachineState
 from internals.objective_function.history import History
@@ -18,16 +19,21 @@ from internals.story import Story
 LOGGER = logging.getLogger('test_runner')
 
 LSS_ASSIGNMENTS_DIR = 'assignments'
+LSS_JOURNAL_NAME = 'journal'
 LSS_INPUT_DIR = 'input'
 LSS_INPUT_NAME = 'input'
 
 
 class Test: #pylint: disable=R0903
-    def __init__(self, test_data_path, run_dir, lss_executable_path, algorithm, log_dir, verbose):
+    def __init__(self, test_data_path, run_dir, lss_executable_path, algorithm, log_dir, verbose,
+                 journal=False, delta_input=False):
         self.has_failed = False
         self.__lss_input_dir = os.path.join(run_dir, LSS_INPUT_DIR)
         self.__lss_input_path = os.path.join(self.__lss_input_dir, LSS_INPUT_NAME)
         self.__lss_assignments_dir = os.path.join(run_dir, LSS_ASSIGNMENTS_DIR)
+        self.__lss_journal_path = os.path.join(run_dir, LSS_JOURNAL_NAME)
+        self.__journal = journal
+        self.__delta_input = delta_input
         self.__lss_executable_path = lss_executable_path
         self.__log_dir = log_dir
         self.__verbose = verbose
@@ -45,14 +51,20 @@ class Test: #pylint: disable=R0903
 
     def run(self):
         self.__prepare_for_running()
+        if self.__journal:
+            assignments_option = "--journal=" + os.path.abspath(self.__lss_journal_path)
+        else:
+            assignments_option = "--assignments=" + os.path.abspath(self.__lss_assignments_dir)
         run_lss_command = "{executable} " \
                           "--input={input} " \
-                          "--assignments={assignments} " \
+                          "--input-format={input_format} " \
+                          "{assignments} " \
                           "--algorithm={algorithm} " \
                           "--verbose={verbose} ".format(**{
             "executable": self.__lss_executable_path,
             "input": os.path.abspath(self.__lss_input_path),
-            "assignments": os.path.abspath(self.__lss_assignments_dir),
+            "input_format": "delta" if self.__delta_input else "basic",
+            "assignments": assignments_option,
             "algorithm": self.__algorithm,
             "verbose": self.__verbose})
         LOGGER.info("Run scheduler with the command: %s", run_lss_command)
@@ -107,15 +119,22 @@ class Test: #pylint: disable=R0903
     def __prepare_for_running(self):
         utils.make_empty_dir(self.__lss_assignments_dir)
         utils.make_empty_dir(self.__lss_input_dir)
+        if os.path.exists(self.__lss_journal_path):
+            os.remove(self.__lss_journal_path)
         self.has_failed = False
         self.state = self.__fresh_state()
         timer.setup(self.__story.get_raw('mint'))
 
     def __fresh_state(self):
+        if self.__journal:
+            assignments = JournalAssignments(self.__lss_journal_path)
+        else:
+            assignments = DirectoryAssignments(self.__lss_assignments_dir)
         return State(
             self.__story,
             self.__lss_input_path,
-            self.__lss_assignments_dir
+            assignments,
+            self.__delta_input
         )
 
     def __determine_quasi_optimal_result(self):
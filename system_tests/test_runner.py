@@ -34,6 +34,12 @@ def parse_args():
     parser.add_argument('-r', '--run-dir',
                         default='/home/vagrant/lss/system_tests/run',
                         help="Specify scheduler input directory (default: /home/vagrant/lss/system_tests/run)")
+    parser.add_argument('-j', '--journal',
+                        action='store_true',
+                        help="Pass assignments through the scheduler journal instead of a directory of files")
+    parser.add_argument('-d', '--delta-input',
+                        action='store_true',
+                        help="Write scheduler input as changes since the previous input (delta format)")
     parser.add_argument('-w', '--without-run',
                         action='store_true',
                         help="Compute test result based on data stored in the scenario. Do not schedule jobs.")
@@ -77,7 +83,9 @@ def run_single_test(test_name, args):
                     scheduler_path,
                     args.algorithm,
                     test_log_dir,
-                    args.verbose)
+                    args.verbose,
+                    args.journal,
+                    args.delta_input)
         if not args.without_run:
             test.run()
         else: